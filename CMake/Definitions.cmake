@@ -90,6 +90,8 @@ foreach(
   REMAP_KEYBOARD_KEYS
   DEVILUTIONX_DEFAULT_RESAMPLER
   STREAM_ALL_AUDIO_MIN_FILE_SIZE
+  SFX_CACHE_MAX_BYTES
+  TILE_LIGHT_CACHE_MAX_BYTES
 )
   if(DEFINED ${def_name} AND NOT ${def_name} STREQUAL "")
     list(APPEND DEVILUTIONX_DEFINITIONS ${def_name}=${${def_name}})
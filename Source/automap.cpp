@@ -5,17 +5,23 @@
  */
 #include "automap.h"
 
+#include <cstring>
+#include <vector>
+
 #include <fmt/format.h>
 
 #include "control.h"
 #include "engine/load_file.hpp"
 #include "engine/palette.h"
+#include "engine/rectangle.hpp"
 #include "engine/render/automap_render.hpp"
+#include "engine/surface.hpp"
 #include "levels/gendung.h"
 #include "levels/setmaps.h"
 #include "player.h"
 #include "utils/language.h"
 #include "utils/stdcompat/algorithm.hpp"
+#include "utils/stdcompat/optional.hpp"
 #include "utils/ui_fwd.h"
 #include "utils/utf8.hpp"
 
@@ -579,6 +585,190 @@ void DrawAutomapTile(const Surface &out, Point center, Point map)
 	}
 }
 
+/** Palette index for the pixels of the automap cache that no tile draws to, automap shapes never use it. */
+constexpr uint8_t AutomapCacheTransparent = 255;
+
+/** Above this size the zoom level is too large to pre-render and the automap is drawn tile by tile instead. */
+constexpr size_t AutomapCacheMaxBytes = 4 * 1024 * 1024;
+
+/** With more changed cells than this the whole cache is redrawn instead. */
+constexpr size_t AutomapCacheMaxDirtyCells = 64;
+
+/**
+ * @brief A horizontal run of opaque pixels in the automap cache.
+ */
+struct AutomapCacheRun {
+	uint16_t x;
+	uint16_t width;
+};
+
+/**
+ * @brief The automap shapes of the whole level, pre-rendered at the current zoom level.
+ *
+ * The shapes only change when tiles are explored or the dungeon changes (doors opening),
+ * so only the tiles around changed cells are redrawn. Each frame only the opaque runs are copied to the screen,
+ * which costs about as much as the pixels the shapes cover.
+ */
+struct AutomapCacheState {
+	std::optional<OwnedSurface> surface;
+	/** The opaque runs of each row of `surface`. */
+	std::vector<std::vector<AutomapCacheRun>> rows;
+	/** `AutoMapScale` the cache was drawn at, 0 when it needs to be drawn from scratch. */
+	int scale = 0;
+	/** Copies of `AutomapView` and `dungeon` from when the cache was last updated. */
+	uint8_t view[DMAXX][DMAXY];
+	uint8_t tiles[DMAXX][DMAXY];
+} AutomapCache;
+
+/**
+ * @brief Returns the position of a tile's center in the automap cache.
+ *
+ * Tiles are laid out on the same lattice as DrawAutomap uses on the screen, with (-1, DMAXY - 1) in the left column and (-1, -1) in the top row.
+ */
+Point GetAutomapCacheCenter(Point map)
+{
+	const int u = map.x - map.y + DMAXY;
+	const int v = map.x + map.y + 2;
+	return {
+		(u >> 1) * AmLine(64) + (u & 1) * AmLine(32) + AmLine(32) + 2,
+		(v >> 1) * AmLine(32) + (v & 1) * AmLine(16) + AmLine(16) + 2,
+	};
+}
+
+/**
+ * @brief Returns the area of the automap cache that the given tile can draw to.
+ */
+Rectangle GetAutomapCacheTileArea(Point map)
+{
+	const Point center = GetAutomapCacheCenter(map);
+	return { { center.x - AmLine(32) - 2, center.y - AmLine(16) - 2 }, Size { 2 * AmLine(32) + 5, 2 * AmLine(16) + 5 } };
+}
+
+/**
+ * @brief Redraws an area of the automap cache from the tiles whose diagonal coordinates (x - y, x + y) fall in the given ranges.
+ *
+ * The tiles are drawn in the same order as DrawAutomap draws them, so overlapping shapes look the same.
+ */
+void DrawAutomapCacheArea(const Rectangle &area, int firstU, int lastU, int firstV, int lastV)
+{
+	const int left = std::max(area.position.x, 0);
+	const int top = std::max(area.position.y, 0);
+	const int right = std::min(area.position.x + area.size.width, AutomapCache.surface->w());
+	const int bottom = std::min(area.position.y + area.size.height, AutomapCache.surface->h());
+	const Surface out = AutomapCache.surface->subregion(left, top, right - left, bottom - top);
+	for (int y = 0; y < out.h(); y++)
+		std::fill_n(out.at(0, y), out.w(), AutomapCacheTransparent);
+
+	for (int v = firstV; v <= lastV; v++) {
+		for (int u = firstU + ((v - firstU) & 1); u <= lastU; u += 2) {
+			const Point map { (v + u) / 2, (v - u) / 2 };
+			if (map.x < -1 || map.x >= DMAXX || map.y < -1 || map.y >= DMAXY)
+				continue;
+			const AutomapTile tile = GetAutomapTypeView(map);
+			if (tile.type == AutomapTile::Types::None && tile.flags == AutomapTile::Flags {})
+				continue;
+			DrawAutomapTile(out, GetAutomapCacheCenter(map) - Displacement { left, top }, map);
+		}
+	}
+
+	for (int y = top; y < bottom; y++) {
+		std::vector<AutomapCacheRun> &runs = AutomapCache.rows[y];
+		runs.clear();
+		const uint8_t *pixels = AutomapCache.surface->at(0, y);
+		const int width = AutomapCache.surface->w();
+		for (int x = 0; x < width;) {
+			if (pixels[x] == AutomapCacheTransparent) {
+				x++;
+				continue;
+			}
+			const int start = x;
+			while (x < width && pixels[x] != AutomapCacheTransparent)
+				x++;
+			runs.push_back({ static_cast<uint16_t>(start), static_cast<uint16_t>(x - start) });
+		}
+	}
+}
+
+/**
+ * @brief Brings the automap cache up to date with the explored tiles and the current zoom level.
+ * @return false if the zoom level is too large to be cached.
+ */
+bool UpdateAutomapCache()
+{
+	if (AutomapCache.scale != AutoMapScale) {
+		const Point bottomRight = GetAutomapCacheCenter({ DMAXX - 1, DMAXY - 1 });
+		const Point right = GetAutomapCacheCenter({ DMAXX - 1, -1 });
+		const Size size { right.x + AmLine(32) + 3, bottomRight.y + AmLine(16) + 3 };
+		if (static_cast<size_t>(size.width) * size.height > AutomapCacheMaxBytes) {
+			AutomapCache.surface = std::nullopt;
+			AutomapCache.rows.clear();
+			AutomapCache.scale = 0;
+			return false;
+		}
+		if (!AutomapCache.surface || AutomapCache.surface->w() != size.width || AutomapCache.surface->h() != size.height) {
+			AutomapCache.surface.emplace(size);
+			AutomapCache.rows.resize(size.height);
+		}
+	} else if (memcmp(AutomapCache.view, AutomapView, sizeof(AutomapView)) == 0 && memcmp(AutomapCache.tiles, dungeon, sizeof(dungeon)) == 0) {
+		return true;
+	}
+
+	std::vector<Point> dirty;
+	if (AutomapCache.scale == AutoMapScale) {
+		for (int x = 0; x < DMAXX && dirty.size() <= AutomapCacheMaxDirtyCells; x++) {
+			for (int y = 0; y < DMAXY; y++) {
+				if (AutomapCache.view[x][y] != AutomapView[x][y] || AutomapCache.tiles[x][y] != dungeon[x][y])
+					dirty.emplace_back(x, y);
+			}
+		}
+	}
+
+	memcpy(AutomapCache.view, AutomapView, sizeof(AutomapView));
+	memcpy(AutomapCache.tiles, dungeon, sizeof(dungeon));
+
+	if (AutomapCache.scale != AutoMapScale || dirty.size() > AutomapCacheMaxDirtyCells) {
+		AutomapCache.scale = AutoMapScale;
+		DrawAutomapCacheArea({ { 0, 0 }, Size { AutomapCache.surface->w(), AutomapCache.surface->h() } }, -DMAXY, DMAXX, -2, DMAXX + DMAXY - 2);
+		return true;
+	}
+
+	for (const Point cell : dirty) {
+		// Tiles also depend on the exploration state and shape of their neighbors, so the tiles next to the cell are redrawn,
+		// along with the parts of the tiles that overlap them.
+		const Rectangle topLeft = GetAutomapCacheTileArea(cell + Displacement { -1, 1 });
+		const Rectangle bottomRight = GetAutomapCacheTileArea(cell + Displacement { 1, -1 });
+		const int top = GetAutomapCacheTileArea(cell + Displacement { -1, -1 }).position.y;
+		const Rectangle bottom = GetAutomapCacheTileArea(cell + Displacement { 1, 1 });
+		const Rectangle area { { topLeft.position.x, top }, Size { bottomRight.position.x + bottomRight.size.width - topLeft.position.x, bottom.position.y + bottom.size.height - top } };
+		const int u = cell.x - cell.y;
+		const int v = cell.x + cell.y;
+		DrawAutomapCacheArea(area, u - 4, u + 4, v - 4, v + 4);
+	}
+	return true;
+}
+
+/**
+ * @brief Copies the opaque pixels of the automap cache to the screen.
+ * @param offset Position of the cache's top left corner on the screen
+ */
+void BlitAutomapCache(const Surface &out, Displacement offset)
+{
+	const int top = std::max(0, -offset.deltaY);
+	const int bottom = std::min(AutomapCache.surface->h(), out.h() - offset.deltaY);
+	const int left = -offset.deltaX;
+	const int right = out.w() - offset.deltaX;
+	for (int y = top; y < bottom; y++) {
+		const uint8_t *src = AutomapCache.surface->at(0, y);
+		uint8_t *dst = out.at(0, y + offset.deltaY);
+		for (const AutomapCacheRun &run : AutomapCache.rows[y]) {
+			const int runLeft = std::max<int>(run.x, left);
+			const int runRight = std::min<int>(run.x + run.width, right);
+			if (runLeft < runRight)
+				memcpy(&dst[runLeft + offset.deltaX], &src[runLeft], runRight - runLeft);
+		}
+	}
+}
+
 void SearchAutomapItem(const Surface &out, const Displacement &myPlayerOffset, int searchRadius, tl::function_ref<bool(Point position)> highlightTile)
 {
 	const Player &player = *MyPlayer;
@@ -819,6 +1009,7 @@ void InitAutomap()
 	}
 
 	memset(AutomapView, 0, sizeof(AutomapView));
+	AutomapCache.scale = 0;
 
 	for (auto &column : dFlags)
 		for (auto &dFlag : column)
@@ -937,21 +1128,25 @@ void DrawAutomap(const Surface &out)
 
 	Point map = { Automap.x - cells, Automap.y - 1 };
 
-	for (int i = 0; i <= cells + 1; i++) {
-		Point tile1 = screen;
-		for (int j = 0; j < cells; j++) {
-			DrawAutomapTile(out, tile1, { map.x + j, map.y - j });
-			tile1.x += AmLine(64);
-		}
-		map.y++;
+	if (UpdateAutomapCache()) {
+		BlitAutomapCache(out, screen - GetAutomapCacheCenter(map));
+	} else {
+		for (int i = 0; i <= cells + 1; i++) {
+			Point tile1 = screen;
+			for (int j = 0; j < cells; j++) {
+				DrawAutomapTile(out, tile1, { map.x + j, map.y - j });
+				tile1.x += AmLine(64);
+			}
+			map.y++;
 
-		Point tile2 { screen.x - AmLine(32), screen.y + AmLine(16) };
-		for (int j = 0; j <= cells; j++) {
-			DrawAutomapTile(out, tile2, { map.x + j, map.y - j });
-			tile2.x += AmLine(64);
+			Point tile2 { screen.x - AmLine(32), screen.y + AmLine(16) };
+			for (int j = 0; j <= cells; j++) {
+				DrawAutomapTile(out, tile2, { map.x + j, map.y - j });
+				tile2.x += AmLine(64);
+			}
+			map.x++;
+			screen.y += AmLine(32);
 		}
-		map.x++;
-		screen.y += AmLine(32);
 	}
 
 	for (size_t playerId = 0; playerId < Players.size(); playerId++) {
@@ -3,9 +3,14 @@
  *
  * Implementation of the screenshot function.
  */
+#include "capture.h"
+
+#include <array>
 #include <cstdint>
 #include <cstdio>
 #include <ctime>
+#include <memory>
+#include <string>
 
 #include <fmt/format.h>
 
@@ -13,16 +18,55 @@
 #include "engine/backbuffer_state.hpp"
 #include "engine/dx.h"
 #include "engine/palette.h"
+#include "engine/render/scrollrt.h"
 #include "utils/file_util.h"
 #include "utils/log.hpp"
 #include "utils/paths.h"
 #include "utils/pcx.hpp"
+#include "utils/sdl_cond.h"
+#include "utils/sdl_mutex.h"
+#include "utils/sdl_thread.h"
 #include "utils/str_cat.hpp"
 #include "utils/ui_fwd.h"
 
+#ifndef USE_SDL1
+#include "utils/png.h"
+#include "utils/sdl_ptrs.h"
+#endif
+
 namespace devilution {
 namespace {
 
+/** Number of captured frames that may wait for the encoder before further frames are dropped. */
+constexpr size_t MaxPendingCaptures = 4;
+
+CaptureFormat ScreenshotFormat = CaptureFormat::Pcx;
+
+/** Capture every Nth frame drawn, 0 if frames are not being captured. */
+int FrameCaptureInterval;
+int FrameCaptureCounter;
+int FrameCaptureNumber;
+int FrameCaptureDropped;
+
+/**
+ * @brief Name and number of the last screenshot, whose file may not be written yet.
+ */
+std::string LastScreenshotName;
+int LastScreenshotNumber;
+
+/**
+ * @brief A copy of the back buffer and palette, waiting to be written to `path`.
+ */
+struct CaptureImage {
+	std::unique_ptr<uint8_t[]> pixels;
+	size_t capacity = 0;
+	int width;
+	int height;
+	SDL_Color palette[256];
+	std::string path;
+	CaptureFormat format;
+};
+
 /**
  * @brief Write the PCX-file header
  * @param width Image width
@@ -114,25 +158,75 @@ uint8_t *CaptureEnc(uint8_t *src, uint8_t *dst, int width)
 /**
  * @brief Write the pixel data to the PCX file
  *
- * @param buf Pixel data
+ * @param image Pixel data
  * @param out File stream for the PCX file.
  * @return True if successful, else false
  */
-bool CapturePix(const Surface &buf, FILE *out)
+bool CapturePix(const CaptureImage &image, FILE *out)
 {
-	int width = buf.w();
+	const int width = image.width;
 	std::unique_ptr<uint8_t[]> pBuffer { new uint8_t[2 * width] };
-	uint8_t *pixels = buf.begin();
-	for (int height = buf.h(); height > 0; height--) {
+	uint8_t *pixels = image.pixels.get();
+	for (int height = image.height; height > 0; height--) {
 		const uint8_t *pBufferEnd = CaptureEnc(pixels, pBuffer.get(), width);
-		pixels += buf.pitch();
+		pixels += width;
 		if (std::fwrite(pBuffer.get(), pBufferEnd - pBuffer.get(), 1, out) != 1)
 			return false;
 	}
 	return true;
 }
 
-FILE *CaptureFile(std::string *dstPath)
+bool WritePcx(CaptureImage &image)
+{
+	FILE *outStream = OpenFile(image.path.c_str(), "wb");
+	if (outStream == nullptr)
+		return false;
+
+	bool success = CaptureHdr(image.width, image.height, outStream);
+	if (success) {
+		success = CapturePix(image, outStream);
+	}
+	if (success) {
+		success = CapturePal(image.palette, outStream);
+	}
+	std::fclose(outStream);
+	if (!success)
+		RemoveFile(image.path.c_str());
+	return success;
+}
+
+#ifndef USE_SDL1
+bool WritePng(CaptureImage &image)
+{
+	// Not using SDLWrap, which throws, as this runs on the encoder's thread.
+	SDLSurfaceUniquePtr surface { SDL_CreateRGBSurfaceWithFormatFrom(image.pixels.get(), image.width, image.height, 8, image.width, SDL_PIXELFORMAT_INDEX8) };
+	if (surface == nullptr)
+		return false;
+	if (SDL_SetPaletteColors(surface->format->palette, image.palette, 0, 256) <= -1)
+		return false;
+	return IMG_SavePNG(surface.get(), image.path.c_str()) == 0;
+}
+#endif
+
+bool WriteCapture(CaptureImage &image)
+{
+#ifndef USE_SDL1
+	if (image.format == CaptureFormat::Png)
+		return WritePng(image);
+#endif
+	return WritePcx(image);
+}
+
+string_view CaptureExtension(CaptureFormat format)
+{
+#ifndef USE_SDL1
+	if (format == CaptureFormat::Png)
+		return ".png";
+#endif
+	return ".pcx";
+}
+
+std::string CaptureFileName()
 {
 	const std::time_t tt = std::time(nullptr);
 	const std::tm *tm = std::localtime(&tt);
@@ -140,13 +234,139 @@ FILE *CaptureFile(std::string *dstPath)
 	    ? fmt::format("Screenshot from {:04}-{:02}-{:02} {:02}-{:02}-{:02}",
 	        tm->tm_year + 1900, tm->tm_mon + 1, tm->tm_mday, tm->tm_hour, tm->tm_min, tm->tm_sec)
 	    : "Screenshot";
-	*dstPath = StrCat(paths::PrefPath(), filename, ".pcx");
-	int i = 0;
-	while (FileExists(dstPath->c_str())) {
+	const string_view extension = CaptureExtension(ScreenshotFormat);
+	// The encoder may not have created the files of earlier screenshots yet, so the numbers used are skipped.
+	int i = filename == LastScreenshotName ? LastScreenshotNumber + 1 : 0;
+	std::string dstPath = i == 0 ? StrCat(paths::PrefPath(), filename, extension) : StrCat(paths::PrefPath(), filename, "-", i, extension);
+	while (FileExists(dstPath.c_str())) {
 		i++;
-		*dstPath = StrCat(paths::PrefPath(), filename, "-", i, ".pcx");
+		dstPath = StrCat(paths::PrefPath(), filename, "-", i, extension);
 	}
-	return OpenFile(dstPath->c_str(), "wb");
+	LastScreenshotName = filename;
+	LastScreenshotNumber = i;
+	return dstPath;
+}
+
+/**
+ * @brief Writes captured images on a separate thread, so that encoding them does not hold up the game.
+ *
+ * Images are written in the order they are submitted. The images are reused once written, so capturing
+ * does not allocate once every buffer has been used at the current resolution.
+ */
+class CaptureWriter {
+public:
+	CaptureWriter()
+	    : thread_(ThreadMain, this)
+	{
+	}
+
+	/**
+	 * @brief Writes the images that are still pending, then stops the thread.
+	 */
+	~CaptureWriter()
+	{
+		mutex_.lock();
+		quit_ = true;
+		imageAvailable_.signal();
+		mutex_.unlock();
+		thread_.join();
+	}
+
+	CaptureWriter(const CaptureWriter &) = delete;
+	CaptureWriter &operator=(const CaptureWriter &) = delete;
+
+	/**
+	 * @brief Returns an image to capture into, which must be passed to `submit` before the next call.
+	 * @param wait Whether to wait for the encoder if all images are pending.
+	 * @return nullptr if `wait` is false and all images are pending.
+	 */
+	CaptureImage *acquire(bool wait)
+	{
+		mutex_.lock();
+		while (wait && count_ == images_.size())
+			slotFree_.wait(mutex_);
+		CaptureImage *image = count_ < images_.size() ? &images_[(head_ + count_) % images_.size()] : nullptr;
+		mutex_.unlock();
+		return image;
+	}
+
+	void submit()
+	{
+		mutex_.lock();
+		count_++;
+		imageAvailable_.signal();
+		mutex_.unlock();
+	}
+
+private:
+	static int SDLCALL ThreadMain(void *data);
+
+	SdlMutex mutex_;
+	SdlCond imageAvailable_;
+	SdlCond slotFree_;
+	std::array<CaptureImage, MaxPendingCaptures> images_;
+	size_t head_ = 0;
+	size_t count_ = 0;
+	bool quit_ = false;
+	// Declared last so that the thread starts once everything else is initialized.
+	SdlThread thread_;
+};
+
+int SDLCALL CaptureWriter::ThreadMain(void *data)
+{
+	auto &writer = *static_cast<CaptureWriter *>(data);
+	writer.mutex_.lock();
+	while (true) {
+		while (!writer.quit_ && writer.count_ == 0)
+			writer.imageAvailable_.wait(writer.mutex_);
+		if (writer.count_ == 0)
+			break;
+		CaptureImage &image = writer.images_[writer.head_];
+		writer.mutex_.unlock();
+		if (WriteCapture(image))
+			LogVerbose("Screenshot saved at {}", image.path);
+		else
+			LogError("Failed to save screenshot at {}", image.path);
+		writer.mutex_.lock();
+		writer.head_ = (writer.head_ + 1) % writer.images_.size();
+		writer.count_--;
+		writer.slotFree_.signal();
+	}
+	writer.mutex_.unlock();
+	return 0;
+}
+
+std::unique_ptr<CaptureWriter> Writer;
+
+/**
+ * @brief Copies the back buffer and the current palette for the encoder to write to `path`.
+ * @param wait Whether to wait for the encoder rather than drop the capture when too many are pending.
+ * @return false if the capture was dropped.
+ */
+bool QueueCapture(std::string path, CaptureFormat format, bool wait)
+{
+	if (Writer == nullptr)
+		Writer = std::make_unique<CaptureWriter>();
+	CaptureImage *image = Writer->acquire(wait);
+	if (image == nullptr)
+		return false;
+
+	const Surface &buf = GlobalBackBuffer();
+	image->width = buf.w();
+	image->height = buf.h();
+	const size_t size = static_cast<size_t>(image->width) * image->height;
+	if (image->capacity < size) {
+		image->pixels = std::unique_ptr<uint8_t[]> { new uint8_t[size] };
+		image->capacity = size;
+	}
+	for (int y = 0; y < image->height; y++)
+		memcpy(&image->pixels[static_cast<size_t>(y) * image->width], &buf[{ 0, y }], image->width);
+	PaletteGetEntries(256, image->palette);
+	image->path = std::move(path);
+	image->format = format;
+
+	Writer->submit();
+	return true;
 }
 
 /**
@@ -164,35 +384,22 @@ void RedPalette()
 }
 } // namespace
 
+void SetScreenshotFormat(CaptureFormat format)
+{
+	ScreenshotFormat = format;
+}
+
 void CaptureScreen()
 {
 	SDL_Color palette[256];
-	std::string fileName;
-	bool success;
 
-	FILE *outStream = CaptureFile(&fileName);
-	if (outStream == nullptr)
-		return;
-	DrawAndBlit();
+	std::string fileName = CaptureFileName();
+	DrawAndBlit(/*startNextView=*/false);
 	PaletteGetEntries(256, palette);
+	Log("Saving screenshot at {}", fileName);
+	QueueCapture(std::move(fileName), ScreenshotFormat, /*wait=*/true);
 	RedPalette();
 
-	const Surface &buf = GlobalBackBuffer();
-	success = CaptureHdr(buf.w(), buf.h(), outStream);
-	if (success) {
-		success = CapturePix(buf, outStream);
-	}
-	if (success) {
-		success = CapturePal(palette, outStream);
-	}
-	std::fclose(outStream);
-
-	if (!success) {
-		Log("Failed to save screenshot at {}", fileName);
-		RemoveFile(fileName.c_str());
-	} else {
-		Log("Screenshot saved at {}", fileName);
-	}
 	SDL_Delay(300);
 	for (int i = 0; i < 256; i++) {
 		system_palette[i] = palette[i];
@@ -201,4 +408,33 @@ void CaptureScreen()
 	RedrawEverything();
 }
 
+void StartFrameCapture(int interval)
+{
+	FrameCaptureInterval = interval;
+	FrameCaptureCounter = 0;
+	FrameCaptureNumber = 0;
+	FrameCaptureDropped = 0;
+}
+
+void CaptureFrame()
+{
+	if (FrameCaptureInterval <= 0)
+		return;
+	if (FrameCaptureCounter++ % FrameCaptureInterval != 0)
+		return;
+
+	// Numbered by frame, so that dropped frames leave a gap rather than shifting the rest of the sequence.
+	const int number = FrameCaptureNumber++;
+	std::string path = StrCat(paths::PrefPath(), fmt::format("frame-{:06}", number), CaptureExtension(ScreenshotFormat));
+	if (!QueueCapture(std::move(path), ScreenshotFormat, /*wait=*/false))
+		FrameCaptureDropped++;
+}
+
+void FinishCapture()
+{
+	Writer = nullptr;
+	if (FrameCaptureDropped != 0)
+		LogError("Dropped {} of {} captured frames, the encoder could not keep up", FrameCaptureDropped, FrameCaptureNumber);
+}
+
 } // namespace devilution
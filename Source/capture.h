@@ -5,11 +5,43 @@
  */
 #pragma once
 
+#include <cstdint>
+
 namespace devilution {
 
+enum class CaptureFormat : uint8_t {
+	Pcx,
+	/** @brief Falls back to PCX when built with SDL1. */
+	Png,
+};
+
+/**
+ * @brief Sets the format of screenshots and captured frames.
+ */
+void SetScreenshotFormat(CaptureFormat format);
+
 /**
- * @brief Save the current screen to a screen??.pcx (00-99) in file if available, then make the screen red for 200ms.
+ * @brief Save the current screen to a new file in the save folder, then make the screen red for 300ms.
+ *
+ * The image is copied and then written on a separate thread.
  */
 void CaptureScreen();
 
+/**
+ * @brief Save every `interval`th frame drawn from now on to frame-000000.pcx, frame-000001.pcx, etc.
+ *
+ * Frames are dropped rather than delaying the game when the encoder falls behind.
+ */
+void StartFrameCapture(int interval);
+
+/**
+ * @brief Called with each frame once it has been drawn to the back buffer.
+ */
+void CaptureFrame();
+
+/**
+ * @brief Waits for the pending captures to be written.
+ */
+void FinishCapture();
+
 } // namespace devilution
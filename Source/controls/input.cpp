@@ -0,0 +1,155 @@
+#include "controls/input.h"
+
+#include <algorithm>
+
+#include "utils/spsc_queue.hpp"
+
+namespace devilution {
+
+namespace {
+
+struct QueuedEvent {
+	SDL_Event event;
+	/** @brief SDL_GetTicks() when SDL received the event. */
+	uint32_t timestamp;
+};
+
+/**
+ * @brief Events taken from SDL that have not been handled yet.
+ *
+ * SDL only pumps events on the thread that initialized the video subsystem, so the producer currently runs on the
+ * main thread as well.
+ */
+SpscQueue<QueuedEvent, 256> InputQueue;
+
+/** @brief When the oldest input handled since the last presented frame was received. */
+std::optional<uint32_t> PendingInputTime;
+
+uint32_t LatencyWindowStart;
+uint32_t LatencyWindowTotal;
+uint32_t LatencyWindowMax;
+uint32_t LatencyWindowSamples;
+std::optional<InputLatency> LastInputLatency;
+
+uint32_t GetTimestamp(const SDL_Event &event)
+{
+#ifndef USE_SDL1
+	if (event.common.timestamp != 0)
+		return event.common.timestamp;
+#endif
+	return SDL_GetTicks();
+}
+
+bool CanMergeMotion(const SDL_Event &previous, const SDL_Event &next)
+{
+#ifndef USE_SDL1
+	if (previous.motion.windowID != next.motion.windowID)
+		return false;
+#endif
+	return previous.motion.which == next.motion.which;
+}
+
+/**
+ * @brief Adds `next` to the earlier motion event `into`, keeping the earlier event's timestamp.
+ */
+void MergeMotion(SDL_Event &into, const SDL_Event &next)
+{
+	into.motion.state = next.motion.state;
+	into.motion.x = next.motion.x;
+	into.motion.y = next.motion.y;
+	into.motion.xrel += next.motion.xrel;
+	into.motion.yrel += next.motion.yrel;
+}
+
+void PumpEvents()
+{
+	std::optional<QueuedEvent> motion;
+	SDL_Event event;
+	// Leaves room for the pending motion event. Events that do not fit stay in SDL's queue until the next pump.
+	while (InputQueue.size() + 2 <= InputQueue.capacity() && SDL_PollEvent(&event) != 0) {
+		if (event.type == SDL_MOUSEMOTION) {
+			if (motion && CanMergeMotion(motion->event, event)) {
+				MergeMotion(motion->event, event);
+				continue;
+			}
+			if (motion)
+				InputQueue.push(*motion);
+			motion = QueuedEvent { event, GetTimestamp(event) };
+			continue;
+		}
+		if (motion) {
+			InputQueue.push(*motion);
+			motion = std::nullopt;
+		}
+		InputQueue.push(QueuedEvent { event, GetTimestamp(event) });
+	}
+	if (motion)
+		InputQueue.push(*motion);
+}
+
+/**
+ * @brief Whether the event is a press that the player expects to see a reaction to.
+ */
+bool IsPress(const SDL_Event &event)
+{
+	switch (event.type) {
+	case SDL_KEYDOWN:
+	case SDL_MOUSEBUTTONDOWN:
+	case SDL_JOYBUTTONDOWN:
+#ifndef USE_SDL1
+	case SDL_CONTROLLERBUTTONDOWN:
+	case SDL_FINGERDOWN:
+#endif
+		return true;
+	default:
+		return false;
+	}
+}
+
+} // namespace
+
+int PollEvent(SDL_Event *event)
+{
+	QueuedEvent queued;
+	if (!InputQueue.pop(queued)) {
+		PumpEvents();
+		if (!InputQueue.pop(queued))
+			return 0;
+	}
+
+	*event = queued.event;
+	UnlockControllerState(*event);
+	if (!PendingInputTime && IsPress(*event))
+		PendingInputTime = queued.timestamp;
+	return 1;
+}
+
+void NotifyFramePresented()
+{
+	const uint32_t now = SDL_GetTicks();
+	if (PendingInputTime) {
+		const uint32_t latency = now - *PendingInputTime;
+		LatencyWindowTotal += latency;
+		LatencyWindowMax = std::max(LatencyWindowMax, latency);
+		LatencyWindowSamples++;
+		PendingInputTime = std::nullopt;
+	}
+
+	if (now - LatencyWindowStart < 1000)
+		return;
+	if (LatencyWindowSamples != 0)
+		LastInputLatency = InputLatency { LatencyWindowTotal / LatencyWindowSamples, LatencyWindowMax };
+	else
+		LastInputLatency = std::nullopt;
+	LatencyWindowStart = now;
+	LatencyWindowTotal = 0;
+	LatencyWindowMax = 0;
+	LatencyWindowSamples = 0;
+}
+
+std::optional<InputLatency> GetInputLatency()
+{
+	return LastInputLatency;
+}
+
+} // namespace devilution
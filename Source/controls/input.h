@@ -1,19 +1,35 @@
 #pragma once
 
+#include <cstdint>
+
 #include <SDL.h>
 
 #include "controls/controller.h"
+#include "utils/stdcompat/optional.hpp"
 
 namespace devilution {
 
-inline int PollEvent(SDL_Event *event)
-{
-	int result = SDL_PollEvent(event);
-	if (result != 0) {
-		UnlockControllerState(*event);
-	}
+/**
+ * @brief Takes the next event from the input queue, refilling the queue from SDL when it is empty.
+ *
+ * Consecutive mouse motion events are merged into one.
+ */
+int PollEvent(SDL_Event *event);
+
+/** @brief Time from an input to the first frame presented after the game handled it. */
+struct InputLatency {
+	uint32_t averageMs;
+	uint32_t maxMs;
+};
+
+/**
+ * @brief Completes the latency measurement of the inputs handled since the previous frame.
+ */
+void NotifyFramePresented();
 
-	return result;
-}
+/**
+ * @brief Latency of the inputs handled in the last full second, or nullopt if there were none.
+ */
+std::optional<InputLatency> GetInputLatency();
 
 } // namespace devilution
@@ -2,7 +2,7 @@
 
 #include <algorithm>
 #include <cstdint>
-#include <list>
+#include <vector>
 
 #ifdef USE_SDL1
 #include "utils/sdl2_to_1_2_backports.h"
@@ -286,20 +286,44 @@ void FindRangedTarget()
 	}
 }
 
+/**
+ * @brief Whether any monster that can be targeted is within the given walking distance of the position
+ *
+ * Checking the active monsters is a lot cheaper than the path search of `FindMeleeTarget`, which
+ * can be skipped when this returns false.
+ */
+bool IsTargetableMonsterNearby(Point position, int maxDistance)
+{
+	for (size_t i = 0; i < ActiveMonsterCount; i++) {
+		const Monster &monster = Monsters[ActiveMonsters[i]];
+		// A moving monster also occupies the tile next to its current one
+		if (monster.position.tile.WalkingDistance(position) <= maxDistance + 1 && CanTargetMonster(monster))
+			return true;
+	}
+	return false;
+}
+
 void FindMeleeTarget()
 {
-	bool visited[MAXDUNX][MAXDUNY] = { {} };
 	int maxSteps = 25; // Max steps for FindPath is 25
 	int rotations = 0;
 	bool canTalk = false;
 
+	Player &myPlayer = *MyPlayer;
+
+	// Monsters are only found next to a tile reached within maxSteps
+	if (!IsTargetableMonsterNearby(myPlayer.position.future, maxSteps + 1))
+		return;
+
 	struct SearchNode {
 		int x, y;
 		int steps;
 	};
-	std::list<SearchNode> queue;
+	static std::vector<SearchNode> queue;
+	queue.clear();
+	size_t queueHead = 0;
 
-	Player &myPlayer = *MyPlayer;
+	bool visited[MAXDUNX][MAXDUNY] = { {} };
 
 	{
 		const int startX = myPlayer.position.future.x;
@@ -308,9 +332,8 @@ void FindMeleeTarget()
 		queue.push_back({ startX, startY, 0 });
 	}
 
-	while (!queue.empty()) {
-		SearchNode node = queue.front();
-		queue.pop_front();
+	while (queueHead < queue.size()) {
+		SearchNode node = queue[queueHead++];
 
 		for (auto pathDir : PathDirs) {
 			const int dx = node.x + pathDir.deltaX;
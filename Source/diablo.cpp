@@ -3,6 +3,7 @@
  *
  * Implementation of the main game initialization functions.
  */
+#include <algorithm>
 #include <array>
 
 #include <fmt/format.h>
@@ -29,9 +30,10 @@
 #include "engine/demomode.h"
 #include "engine/dx.h"
 #include "engine/events.hpp"
-#include "engine/load_cel.hpp"
-#include "engine/load_file.hpp"
+#include "engine/frame_pacing.hpp"
+#include "engine/level_prefetch.hpp"
 #include "engine/random.hpp"
+#include "engine/render/dun_render.hpp"
 #include "engine/sound.h"
 #include "error.h"
 #include "gamemenu.h"
@@ -150,6 +152,10 @@ bool was_archives_init = false;
 /** To know if surfaces have been initialized or not */
 bool was_window_init = false;
 bool was_ui_init = false;
+#ifndef DISABLE_DEMOMODE
+/** Demo to replay without a window, see `RunHeadlessDemo` */
+int HeadlessDemoNumber = -1;
+#endif
 
 void StartGame(interface_mode uMsg)
 {
@@ -753,12 +759,16 @@ void GameEventHandler(const SDL_Event &event, uint16_t modState)
 		return;
 	default:
 		if (IsCustomEvent(event.type)) {
+			const interface_mode uMsg = GetCustomEvent(event.type);
+			PrefetchProgressLevel(uMsg);
 			if (gbIsMultiplayer)
 				pfile_write_hero();
 			nthread_ignore_mutex(true);
+			// The fade presents the back buffer.
+			DiscardGameViewRendering();
 			PaletteFadeOut(8);
 			sound_stop();
-			ShowProgress(GetCustomEvent(event.type));
+			ShowProgress(uMsg);
 
 			RedrawEverything();
 			if (!HeadlessMode) {
@@ -826,6 +836,8 @@ void RunGameLoop(interface_mode uMsg)
 		}
 #endif
 
+		PaceFrameStart();
+
 		SDL_Event event;
 		uint16_t modState;
 		while (FetchMessage(&event, &modState)) {
@@ -857,18 +869,22 @@ void RunGameLoop(interface_mode uMsg)
 			continue;
 		}
 
+		demo::NotifyLogicStart();
 		multi_process_network_packets();
 		if (game_loop(gbGameLoopStartup))
 			diablo_color_cyc_logic();
 		gbGameLoopStartup = false;
+		demo::NotifyRenderStart();
 		if (drawGame)
 			DrawAndBlit();
+		demo::NotifyFrameEnd();
 #ifdef GPERF_HEAP_FIRST_GAME_ITERATION
 		if (run_game_iteration++ == 0)
 			HeapProfilerDump("first_game_iteration");
 #endif
 	}
 
+	StopGameViewRendering();
 	demo::NotifyGameLoopEnd();
 
 	if (gbIsMultiplayer) {
@@ -921,10 +937,14 @@ void PrintHelpOption(string_view flags, string_view description)
 	PrintHelpOption("-n", _(/* TRANSLATORS: Commandline Option */ "Skip startup videos"));
 	PrintHelpOption("-f", _(/* TRANSLATORS: Commandline Option */ "Display frames per second"));
 	PrintHelpOption("--verbose", _(/* TRANSLATORS: Commandline Option */ "Enable verbose logging"));
+	PrintHelpOption("--screenshot-format <pcx|png>", _(/* TRANSLATORS: Commandline Option */ "Save screenshots as pcx or png"));
+	PrintHelpOption("--capture <#>", _(/* TRANSLATORS: Commandline Option */ "Save every Nth frame to a numbered screenshot"));
 #ifndef DISABLE_DEMOMODE
 	PrintHelpOption("--record <#>", _(/* TRANSLATORS: Commandline Option */ "Record a demo file"));
 	PrintHelpOption("--demo <#>", _(/* TRANSLATORS: Commandline Option */ "Play a demo file"));
 	PrintHelpOption("--timedemo", _(/* TRANSLATORS: Commandline Option */ "Disable all frame limiting during demo playback"));
+	PrintHelpOption("--benchmark <file>", _(/* TRANSLATORS: Commandline Option */ "Write per-frame timings of a timedemo as JSON"));
+	PrintHelpOption("--headless", _(/* TRANSLATORS: Commandline Option */ "Replay the demo without window, audio or frame limiting and report ticks per second"));
 #endif
 	printNewlineInConsole();
 	printInConsole(_(/* TRANSLATORS: Commandline Option */ "Game selection:"));
@@ -962,9 +982,11 @@ void DiabloParseFlags(int argc, char **argv)
 #endif
 #ifndef DISABLE_DEMOMODE
 	bool timedemo = false;
+	bool headless = false;
 	int demoNumber = -1;
 	int recordNumber = -1;
 	bool createDemoReference = false;
+	std::string benchmarkOutputPath;
 #endif
 	for (int i = 1; i < argc; i++) {
 		const string_view arg = argv[i];
@@ -1010,6 +1032,15 @@ void DiabloParseFlags(int argc, char **argv)
 			gbShowIntro = false;
 		} else if (arg == "--timedemo") {
 			timedemo = true;
+		} else if (arg == "--headless") {
+			headless = true;
+		} else if (arg == "--benchmark") {
+			if (i + 1 == argc) {
+				PrintFlagsRequiresArgument("--benchmark");
+				diablo_quit(64);
+			}
+			benchmarkOutputPath = argv[++i];
+			timedemo = true;
 		} else if (arg == "--record") {
 			if (i + 1 == argc) {
 				PrintFlagsRequiresArgument("--record");
@@ -1019,7 +1050,7 @@ void DiabloParseFlags(int argc, char **argv)
 		} else if (arg == "--create-reference") {
 			createDemoReference = true;
 #else
-		} else if (arg == "--demo" || arg == "--timedemo" || arg == "--record" || arg == "--create-reference") {
+		} else if (arg == "--demo" || arg == "--timedemo" || arg == "--benchmark" || arg == "--headless" || arg == "--record" || arg == "--create-reference") {
 			printInConsole("Binary compiled without demo mode support.");
 			printNewlineInConsole();
 			diablo_quit(1);
@@ -1038,6 +1069,27 @@ void DiabloParseFlags(int argc, char **argv)
 			gbVanilla = true;
 		} else if (arg == "--verbose") {
 			SDL_LogSetAllPriority(SDL_LOG_PRIORITY_VERBOSE);
+		} else if (arg == "--screenshot-format") {
+			if (i + 1 == argc) {
+				PrintFlagsRequiresArgument("--screenshot-format");
+				diablo_quit(64);
+			}
+			const string_view format = argv[++i];
+			if (format == "png") {
+				SetScreenshotFormat(CaptureFormat::Png);
+			} else if (format == "pcx") {
+				SetScreenshotFormat(CaptureFormat::Pcx);
+			} else {
+				printInConsole("--screenshot-format must be pcx or png");
+				printNewlineInConsole();
+				diablo_quit(64);
+			}
+		} else if (arg == "--capture") {
+			if (i + 1 == argc) {
+				PrintFlagsRequiresArgument("--capture");
+				diablo_quit(64);
+			}
+			StartFrameCapture(std::max(SDL_atoi(argv[++i]), 1));
 #ifdef _DEBUG
 		} else if (arg == "-i") {
 			DebugDisableNetworkTimeout = true;
@@ -1066,8 +1118,20 @@ void DiabloParseFlags(int argc, char **argv)
 #endif
 
 #ifndef DISABLE_DEMOMODE
+	if (headless) {
+		if (demoNumber == -1) {
+			printInConsole("--headless requires --demo");
+			printNewlineInConsole();
+			diablo_quit(64);
+		}
+		HeadlessMode = true;
+		HeadlessDemoNumber = demoNumber;
+		timedemo = true;
+	}
 	if (demoNumber != -1)
 		demo::InitPlayBack(demoNumber, timedemo);
+	if (demoNumber != -1 && !benchmarkOutputPath.empty())
+		demo::InitBenchmark(std::move(benchmarkOutputPath));
 	if (recordNumber != -1)
 		demo::InitRecording(recordNumber, createDemoReference);
 #endif
@@ -1200,8 +1264,60 @@ void DiabloSplash()
 		UiTitleDialog();
 }
 
+#ifndef DISABLE_DEMOMODE
+/**
+ * @brief Replays the demo selected by `--headless` as fast as possible, without a window, audio or the main menu
+ * @return Exit code, non-zero if the outcome differs from the reference save of the demo
+ */
+int RunHeadlessDemo()
+{
+	LanguageInitialize();
+	LoadGameArchives();
+	if (!HaveSpawn() && !HaveDiabdat()) {
+		LogError("--headless requires diabdat.mpq or spawn.mpq");
+		return 1;
+	}
+
+	if (forceSpawn || *sgOptions.StartUp.shareware)
+		gbIsSpawn = true;
+	if (forceDiablo || *sgOptions.StartUp.gameMode == StartUpGameMode::Diablo)
+		gbIsHellfire = false;
+	if (forceHellfire)
+		gbIsHellfire = true;
+	gbIsHellfireSaveGame = gbIsHellfire;
+	gbMusicOn = false;
+	gbSoundOn = false;
+
+	Players.resize(1);
+	MyPlayerId = 0;
+	MyPlayer = &Players[MyPlayerId];
+	*MyPlayer = {};
+	pfile_ui_set_hero_infos([](_uiheroinfo *) { return true; });
+	gbLoadGame = true;
+
+	demo::OverrideOptions();
+	AdjustToScreenGeometry(forceResolution);
+	devilution::StartGame(false, true);
+
+	const HeroCompareResult result = pfile_compare_hero_demo(HeadlessDemoNumber, true);
+	switch (result.status) {
+	case HeroCompareResult::ReferenceNotFound:
+		Log("Headless: No final comparison cause reference is not present.");
+		return 0;
+	case HeroCompareResult::Same:
+		Log("Headless: Same outcome as initial run.");
+		return 0;
+	case HeroCompareResult::Difference:
+		Log("Headless: Different outcome than initial run.\n{}", result.message);
+		return 1;
+	}
+	return 0;
+}
+#endif
+
 void DiabloDeinit()
 {
+	FinishCapture();
 	FreeItemGFX();
 
 	if (gbSndInited)
@@ -1221,52 +1337,13 @@ void DiabloDeinit()
 void LoadLvlGFX()
 {
 	assert(pDungeonCels == nullptr);
-	constexpr int SpecialCelWidth = 64;
 
-	switch (leveltype) {
-	case DTYPE_TOWN:
-		if (gbIsHellfire) {
-			pDungeonCels = LoadFileInMem("nlevels\\towndata\\town.cel");
-			pMegaTiles = LoadFileInMem<MegaTile>("nlevels\\towndata\\town.til");
-		} else {
-			pDungeonCels = LoadFileInMem("levels\\towndata\\town.cel");
-			pMegaTiles = LoadFileInMem<MegaTile>("levels\\towndata\\town.til");
-		}
-		pSpecialCels = LoadCel("levels\\towndata\\towns", SpecialCelWidth);
-		break;
-	case DTYPE_CATHEDRAL:
-		pDungeonCels = LoadFileInMem("levels\\l1data\\l1.cel");
-		pMegaTiles = LoadFileInMem<MegaTile>("levels\\l1data\\l1.til");
-		pSpecialCels = LoadCel("levels\\l1data\\l1s", SpecialCelWidth);
-		break;
-	case DTYPE_CATACOMBS:
-		pDungeonCels = LoadFileInMem("levels\\l2data\\l2.cel");
-		pMegaTiles = LoadFileInMem<MegaTile>("levels\\l2data\\l2.til");
-		pSpecialCels = LoadCel("levels\\l2data\\l2s", SpecialCelWidth);
-		break;
-	case DTYPE_CAVES:
-		pDungeonCels = LoadFileInMem("levels\\l3data\\l3.cel");
-		pMegaTiles = LoadFileInMem<MegaTile>("levels\\l3data\\l3.til");
-		pSpecialCels = LoadCel("levels\\l1data\\l1s", SpecialCelWidth);
-		break;
-	case DTYPE_HELL:
-		pDungeonCels = LoadFileInMem("levels\\l4data\\l4.cel");
-		pMegaTiles = LoadFileInMem<MegaTile>("levels\\l4data\\l4.til");
-		pSpecialCels = LoadCel("levels\\l2data\\l2s", SpecialCelWidth);
-		break;
-	case DTYPE_NEST:
-		pDungeonCels = LoadFileInMem("nlevels\\l6data\\l6.cel");
-		pMegaTiles = LoadFileInMem<MegaTile>("nlevels\\l6data\\l6.til");
-		pSpecialCels = LoadCel("levels\\l1data\\l1s", SpecialCelWidth);
-		break;
-	case DTYPE_CRYPT:
-		pDungeonCels = LoadFileInMem("nlevels\\l5data\\l5.cel");
-		pMegaTiles = LoadFileInMem<MegaTile>("nlevels\\l5data\\l5.til");
-		pSpecialCels = LoadCel("nlevels\\l5data\\l5s", SpecialCelWidth);
-		break;
-	default:
-		app_fatal("LoadLvlGFX");
-	}
+	const TilesetPaths paths = GetTilesetPaths(leveltype);
+	pDungeonCels = LoadPrefetchedFileInMem(paths.cel);
+	pMegaTiles = LoadPrefetchedFileInMem<MegaTile>(paths.til);
+	pSpecialCels = LoadPrefetchedCel(paths.specialCel, SpecialCelWidth);
+
+	ClearTileLightCache();
 }
 
 void LoadAllGFX()
@@ -2321,6 +2398,8 @@ void SetCursorPos(Point position)
 
 void FreeGameMem()
 {
+	DiscardGameViewRendering();
+
 	pDungeonCels = nullptr;
 	pMegaTiles = nullptr;
 	pSpecialCels = std::nullopt;
@@ -2419,6 +2498,14 @@ int DiabloMain(int argc, char **argv)
 	// Then look for a voice pack file based on the selected translation
 	LoadLanguageArchive();
 
+#ifndef DISABLE_DEMOMODE
+	if (HeadlessMode) {
+		const int exitCode = RunHeadlessDemo();
+		DiabloDeinit();
+		return exitCode;
+	}
+#endif
+
 	ApplicationInit();
 	SaveOptions();
 
@@ -2990,6 +3077,12 @@ void diablo_color_cyc_logic()
 	if (PauseMode != 0)
 		return;
 
+	if (!IsAnyOf(leveltype, DTYPE_CAVES, DTYPE_HELL, DTYPE_NEST, DTYPE_CRYPT))
+		return;
+
+	// The game view that is rendered in the background blends and lights through the tables that are cycled.
+	WaitForGameViewRendering();
+
 	if (leveltype == DTYPE_CAVES) {
 		if (setlevel && setlvlnum == Quests[Q_PWATER]._qslvl) {
 			UpdatePWaterPalette();
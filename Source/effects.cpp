@@ -5,6 +5,8 @@
  */
 #include "effects.h"
 
+#include <cstddef>
+
 #include "engine/random.hpp"
 #include "engine/sound.h"
 #include "engine/sound_defs.hpp"
@@ -27,6 +29,12 @@ constexpr bool AllowStreaming = true;
 constexpr bool AllowStreaming = false;
 #endif
 
+#ifdef SFX_CACHE_MAX_BYTES
+constexpr size_t SfxCacheMaxBytes = SFX_CACHE_MAX_BYTES;
+#else
+constexpr size_t SfxCacheMaxBytes = 64 * 1024 * 1024;
+#endif
+
 /** Specifies the sound file and the playback state of the current sound effect. */
 TSFX *sgpStreamSFX = nullptr;
 
@@ -967,6 +975,48 @@ TSFX sgSFX[] = {
 	// clang-format on
 };
 
+size_t GetSfxCacheSize()
+{
+	size_t size = 0;
+	for (const TSFX &sfx : sgSFX) {
+		if (sfx.pSnd != nullptr)
+			size += sfx.pSnd->DSB.GetMemoryUsage();
+	}
+	return size;
+}
+
+/**
+ * @brief Unloads the least recently played idle sound effects until the cache fits into its budget.
+ * @param keep Sound effect that must stay loaded
+ */
+void ShrinkSfxCache(const TSFX &keep)
+{
+	size_t size = GetSfxCacheSize();
+	while (size > SfxCacheMaxBytes) {
+		TSFX *oldest = nullptr;
+		for (TSFX &sfx : sgSFX) {
+			if (&sfx == &keep || sfx.pSnd == nullptr || (sfx.bFlags & sfx_STREAM) != 0 || sfx.pSnd->DSB.GetMemoryUsage() == 0 || sfx.pSnd->isPlaying())
+				continue;
+			if (oldest == nullptr || sfx.pSnd->start_tc < oldest->pSnd->start_tc)
+				oldest = &sfx;
+		}
+		if (oldest == nullptr)
+			return;
+		size -= oldest->pSnd->DSB.GetMemoryUsage();
+		oldest->pSnd = nullptr;
+	}
+}
+
+/**
+ * @brief Loads a non-streamed sound effect, evicting other effects if the cache is over budget.
+ */
+void LoadSfx(TSFX &sfx)
+{
+	sfx.pSnd = sound_file_load(sfx.pszName);
+	if (sfx.pSnd != nullptr)
+		ShrinkSfxCache(sfx);
+}
+
 void StreamPlay(TSFX *pSFX, int lVolume, int lPan)
 {
 	assert(pSFX);
@@ -1016,7 +1066,7 @@ void PlaySfxPriv(TSFX *pSFX, bool loc, Point position)
 	}
 
 	if (pSFX->pSnd == nullptr)
-		pSFX->pSnd = sound_file_load(pSFX->pszName);
+		LoadSfx(*pSFX);
 
 	if (pSFX->pSnd != nullptr && pSFX->pSnd->DSB.IsLoaded())
 		snd_play_snd(pSFX->pSnd.get(), lVolume, lPan);
@@ -1059,6 +1109,7 @@ void PrivSoundInit(uint8_t bLoadMask)
 		return;
 	}
 
+	size_t cacheSize = GetSfxCacheSize();
 	for (auto &sfx : sgSFX) {
 		if (sfx.bFlags == 0 || sfx.pSnd != nullptr) {
 			continue;
@@ -1076,7 +1127,13 @@ void PrivSoundInit(uint8_t bLoadMask)
 			continue;
 		}
 
+		// Whatever doesn't fit into the cache is loaded on first use instead.
+		if (cacheSize >= SfxCacheMaxBytes) {
+			return;
+		}
+
 		sfx.pSnd = sound_file_load(sfx.pszName);
+		cacheSize += sfx.pSnd->DSB.GetMemoryUsage();
 	}
 }
 
@@ -1155,35 +1212,8 @@ void effects_cleanup_sfx()
 
 void sound_init()
 {
-	uint8_t mask = sfx_MISC;
-	if (gbIsMultiplayer) {
-		mask |= sfx_WARRIOR;
-		if (!gbIsSpawn)
-			mask |= (sfx_ROGUE | sfx_SORCERER);
-		if (gbIsHellfire)
-			mask |= sfx_MONK;
-	} else {
-		switch (MyPlayer->_pClass) {
-		case HeroClass::Warrior:
-		case HeroClass::Barbarian:
-			mask |= sfx_WARRIOR;
-			break;
-		case HeroClass::Rogue:
-		case HeroClass::Bard:
-			mask |= sfx_ROGUE;
-			break;
-		case HeroClass::Sorcerer:
-			mask |= sfx_SORCERER;
-			break;
-		case HeroClass::Monk:
-			mask |= sfx_MONK;
-			break;
-		default:
-			app_fatal("effects:1");
-		}
-	}
-
-	PrivSoundInit(mask);
+	// Hero speech is rarely heard and only loaded on first use.
+	PrivSoundInit(sfx_MISC);
 }
 
 void ui_sound_init()
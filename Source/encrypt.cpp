@@ -57,6 +57,45 @@ const std::array<std::array<uint32_t, 256>, 5> hashtable = []() {
 	return ret;
 }();
 
+/**
+ * @brief Scratch memory for implode/explode, kept around so that compressing many small buffers does not allocate each time.
+ */
+struct PkwareWorkspace {
+	std::unique_ptr<char[]> workData = std::make_unique<char[]>(CMP_BUFFER_SIZE);
+	std::unique_ptr<byte[]> outputData;
+	size_t outputSize = 0;
+
+	/**
+	 * @brief Returns the implode/explode work buffer, cleared so that leftovers from the previous call cannot change the output.
+	 */
+	char *work()
+	{
+		memset(workData.get(), 0, CMP_BUFFER_SIZE);
+		return workData.get();
+	}
+
+	/**
+	 * @brief Returns a buffer of at least `size` bytes, only valid until the next call.
+	 */
+	byte *output(size_t size)
+	{
+		if (size > outputSize) {
+			outputData.reset(new byte[size]);
+			outputSize = size;
+		}
+		return outputData.get();
+	}
+};
+
+/**
+ * @brief Each thread gets its own workspace, so that sectors can be compressed in parallel.
+ */
+PkwareWorkspace &GetPkwareWorkspace()
+{
+	thread_local PkwareWorkspace workspace;
+	return workspace;
+}
+
 } // namespace
 
 void Decrypt(uint32_t *castBlock, uint32_t size, uint32_t key)
@@ -101,49 +140,53 @@ uint32_t Hash(const char *s, int type)
 	return seed1;
 }
 
-uint32_t PkwareCompress(byte *srcData, uint32_t size)
+uint32_t PkwareCompress(const byte *srcData, uint32_t size, byte *destData)
 {
-	std::unique_ptr<char[]> ptr = std::make_unique<char[]>(CMP_BUFFER_SIZE);
+	PkwareWorkspace &workspace = GetPkwareWorkspace();
 
 	unsigned destSize = 2 * size;
 	if (destSize < 2 * 4096)
 		destSize = 2 * 4096;
 
-	std::unique_ptr<byte[]> destData { new byte[destSize] };
-
 	TDataInfo param;
-	param.srcData = srcData;
+	param.srcData = const_cast<byte *>(srcData);
 	param.srcOffset = 0;
-	param.destData = destData.get();
+	param.destData = workspace.output(destSize);
 	param.destOffset = 0;
 	param.size = size;
 
 	unsigned type = 0;
 	unsigned dsize = 4096;
-	implode(PkwareBufferRead, PkwareBufferWrite, ptr.get(), &param, &type, &dsize);
+	implode(PkwareBufferRead, PkwareBufferWrite, workspace.work(), &param, &type, &dsize);
 
 	if (param.destOffset < size) {
-		memcpy(srcData, destData.get(), param.destOffset);
-		size = param.destOffset;
+		memcpy(destData, param.destData, param.destOffset);
+		return param.destOffset;
 	}
 
+	if (destData != srcData)
+		memcpy(destData, srcData, size);
 	return size;
 }
 
+uint32_t PkwareCompress(byte *srcData, uint32_t size)
+{
+	return PkwareCompress(srcData, size, srcData);
+}
+
 void PkwareDecompress(byte *inBuff, uint32_t recvSize, int maxBytes)
 {
-	std::unique_ptr<char[]> ptr = std::make_unique<char[]>(CMP_BUFFER_SIZE);
-	std::unique_ptr<byte[]> outBuff { new byte[maxBytes] };
+	PkwareWorkspace &workspace = GetPkwareWorkspace();
 
 	TDataInfo info;
 	info.srcData = inBuff;
 	info.srcOffset = 0;
-	info.destData = outBuff.get();
+	info.destData = workspace.output(maxBytes);
 	info.destOffset = 0;
 	info.size = recvSize;
 
-	explode(PkwareBufferRead, PkwareBufferWrite, ptr.get(), &info);
-	memcpy(inBuff, outBuff.get(), info.destOffset);
+	explode(PkwareBufferRead, PkwareBufferWrite, workspace.work(), &info);
+	memcpy(inBuff, info.destData, info.destOffset);
 }
 
 } // namespace devilution
@@ -23,6 +23,13 @@ void Decrypt(uint32_t *castBlock, uint32_t size, uint32_t key);
 void Encrypt(uint32_t *castBlock, uint32_t size, uint32_t key);
 uint32_t Hash(const char *s, int type);
 uint32_t PkwareCompress(byte *srcData, uint32_t size);
+
+/**
+ * @brief Compresses `srcData` into `destData`, storing it uncompressed if that is not smaller.
+ * @param destData Receives the result, must hold at least `size` bytes and may be the same as `srcData`.
+ * @return The number of bytes written to `destData`.
+ */
+uint32_t PkwareCompress(const byte *srcData, uint32_t size, byte *destData);
 void PkwareDecompress(byte *inBuff, uint32_t recvSize, int maxBytes);
 
 } // namespace devilution
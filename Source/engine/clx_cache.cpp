@@ -0,0 +1,275 @@
+#include "engine/clx_cache.hpp"
+
+#include <cstdio>
+#include <cstring>
+#include <memory>
+#include <string>
+
+#include <fmt/format.h>
+
+#include "options.h"
+#include "utils/endian.hpp"
+#include "utils/file_util.h"
+#include "utils/log.hpp"
+#include "utils/paths.h"
+#include "utils/stdcompat/string_view.hpp"
+#include "utils/str_cat.hpp"
+
+#ifndef UNPACKED_MPQS
+#include "engine/assets.hpp"
+#include "mpq/mpq_reader.hpp"
+#endif
+
+namespace devilution {
+
+namespace {
+
+/** @brief Bump when the CLX format or a conversion changes, so that older entries are ignored. */
+constexpr uint32_t CacheVersion = 1;
+
+constexpr char CacheMagic[4] = { 'D', 'X', 'C', 'X' };
+
+/**
+ * Magic, version, entry and source hash, payload size, checksum, number of lists
+ * and whether a palette follows the payload.
+ */
+constexpr size_t CacheHeaderSize = 4 + 4 + 8 + 8 + 4 + 4 + 2 + 2;
+
+constexpr size_t CachePaletteSize = 256 * 3;
+
+/** @brief Larger sprites are converted on every load rather than cached. */
+constexpr size_t MaxCachedClxSize = 16 * 1024 * 1024;
+
+/** @brief 64-bit FNV-1a over the added values. */
+class CacheKeyHasher {
+public:
+	template <typename T>
+	void add(T value)
+	{
+		const auto *bytes = reinterpret_cast<const uint8_t *>(&value);
+		for (size_t i = 0; i < sizeof(value); i++)
+			addByte(bytes[i]);
+	}
+
+	void add(string_view str)
+	{
+		for (const char c : str)
+			addByte(static_cast<uint8_t>(c));
+		addByte(0);
+	}
+
+	[[nodiscard]] uint64_t value() const
+	{
+		return hash_;
+	}
+
+private:
+	void addByte(uint8_t byte)
+	{
+		hash_ ^= byte;
+		hash_ *= 1099511628211ULL;
+	}
+
+	uint64_t hash_ = 14695981039346656037ULL;
+};
+
+/**
+ * @brief Cheap checksum of the payload that catches truncated and damaged cache files.
+ */
+uint32_t Checksum(const uint8_t *data, size_t size)
+{
+	uint32_t hash = 2166136261U;
+	size_t i = 0;
+	for (; i + 4 <= size; i += 4) {
+		hash ^= LoadLE32(&data[i]);
+		hash *= 16777619U;
+	}
+	for (; i < size; i++) {
+		hash ^= data[i];
+		hash *= 16777619U;
+	}
+	return hash;
+}
+
+uint64_t LoadHash(const uint8_t *data)
+{
+	return static_cast<uint64_t>(LoadLE32(&data[4])) << 32 | LoadLE32(data);
+}
+
+void WriteHash(uint8_t *out, uint64_t hash)
+{
+	WriteLE32(out, static_cast<uint32_t>(hash));
+	WriteLE32(&out[4], static_cast<uint32_t>(hash >> 32));
+}
+
+size_t GetClxDataSize(ClxSpriteListOrSheet sprites)
+{
+	if (!sprites.isSheet())
+		return sprites.list().nextSpriteSheetOffsetOrFileSize();
+	const ClxSpriteSheet sheet = sprites.sheet();
+	const size_t lastList = sheet.numLists() - 1;
+	return sheet.sheetOffset(lastList) + sheet[lastList].nextSpriteSheetOffsetOrFileSize();
+}
+
+std::string CacheDirectory()
+{
+	return StrCat(paths::PrefPath(), "cache", DIRECTORY_SEPARATOR_STR);
+}
+
+std::string CachePath(const ClxCacheKey &key)
+{
+	return StrCat(CacheDirectory(), fmt::format("{:016x}", key.entry), ".clx");
+}
+
+#ifndef UNPACKED_MPQS
+std::optional<ClxCacheKey> MakeClxCacheKey(const char *path, const CacheKeyHasher &parameters)
+{
+	if (!*sgOptions.Graphics.spriteCache)
+		return std::nullopt;
+
+	const AssetRef ref = FindAsset(path);
+	// Loose files are overrides that may change at any time.
+	if (ref.archive == nullptr)
+		return std::nullopt;
+
+	CacheKeyHasher entry = parameters;
+	entry.add(string_view(path));
+
+	CacheKeyHasher source;
+	const std::string &archivePath = ref.archive->path();
+	source.add(string_view(archivePath));
+	std::uintmax_t archiveSize = 0;
+	GetFileSize(archivePath.c_str(), &archiveSize);
+	source.add(static_cast<uint64_t>(archiveSize));
+	std::int64_t archiveModified = 0;
+	GetFileModificationTime(archivePath.c_str(), &archiveModified);
+	source.add(archiveModified);
+	source.add(ref.fileNumber);
+	source.add(static_cast<uint64_t>(ref.size()));
+
+	return ClxCacheKey { entry.value(), source.value() };
+}
+#endif
+
+} // namespace
+
+#ifndef UNPACKED_MPQS
+std::optional<ClxCacheKey> GetClxCacheKey(const char *path, PointerOrValue<uint16_t> widthOrWidths)
+{
+	// The number of widths is only known once the file is read.
+	if (widthOrWidths.HoldsPointer())
+		return std::nullopt;
+
+	CacheKeyHasher parameters;
+	parameters.add(CacheVersion);
+	parameters.add(widthOrWidths.AsValue());
+	return MakeClxCacheKey(path, parameters);
+}
+
+std::optional<ClxCacheKey> GetClxCacheKey(const char *path, int numFramesOrFrameHeight, std::optional<uint8_t> transparentColor, bool withPalette)
+{
+	CacheKeyHasher parameters;
+	parameters.add(CacheVersion);
+	parameters.add(numFramesOrFrameHeight);
+	parameters.add(transparentColor ? static_cast<int>(*transparentColor) : -1);
+	parameters.add(withPalette);
+	return MakeClxCacheKey(path, parameters);
+}
+#endif
+
+OptionalOwnedClxSpriteListOrSheet LoadCachedClx(const ClxCacheKey &key, SDL_Color *outPalette)
+{
+	const std::string path = CachePath(key);
+	FILE *file = OpenFile(path.c_str(), "rb");
+	if (file == nullptr)
+		return std::nullopt;
+
+	uint8_t header[CacheHeaderSize];
+	std::unique_ptr<uint8_t[]> data;
+	uint16_t numLists = 0;
+	bool valid = std::fread(header, sizeof(header), 1, file) == 1
+	    && memcmp(header, CacheMagic, sizeof(CacheMagic)) == 0
+	    && LoadLE32(&header[4]) == CacheVersion
+	    && LoadHash(&header[8]) == key.entry
+	    && LoadHash(&header[16]) == key.source;
+	if (valid) {
+		const uint32_t size = LoadLE32(&header[24]);
+		const uint32_t checksum = LoadLE32(&header[28]);
+		numLists = LoadLE16(&header[32]);
+		const bool hasPalette = LoadLE16(&header[34]) != 0;
+		valid = size != 0 && size <= MaxCachedClxSize && (outPalette == nullptr || hasPalette);
+		if (valid) {
+			data = std::unique_ptr<uint8_t[]> { new uint8_t[size] };
+			valid = std::fread(data.get(), size, 1, file) == 1 && Checksum(data.get(), size) == checksum;
+		}
+		if (valid && outPalette != nullptr) {
+			uint8_t palette[CachePaletteSize];
+			valid = std::fread(palette, sizeof(palette), 1, file) == 1;
+			for (unsigned i = 0; valid && i < 256; i++) {
+				outPalette[i].r = palette[i * 3];
+				outPalette[i].g = palette[i * 3 + 1];
+				outPalette[i].b = palette[i * 3 + 2];
+#ifndef USE_SDL1
+				outPalette[i].a = SDL_ALPHA_OPAQUE;
+#endif
+			}
+		}
+	}
+	std::fclose(file);
+
+	if (!valid) {
+		LogVerbose("Ignoring stale sprite cache entry {}", path);
+		return std::nullopt;
+	}
+	return OwnedClxSpriteListOrSheet { std::move(data), numLists };
+}
+
+void StoreCachedClx(const ClxCacheKey &key, ClxSpriteListOrSheet sprites, const SDL_Color *palette)
+{
+	const uint8_t *data = sprites.isSheet() ? sprites.sheet().data() : sprites.list().data();
+	const size_t size = GetClxDataSize(sprites);
+	if (size > MaxCachedClxSize)
+		return;
+
+	const std::string directory = CacheDirectory();
+	if (!DirectoryExists(directory.c_str()))
+		RecursivelyCreateDir(directory.c_str());
+
+	uint8_t header[CacheHeaderSize];
+	memcpy(header, CacheMagic, sizeof(CacheMagic));
+	WriteLE32(&header[4], CacheVersion);
+	WriteHash(&header[8], key.entry);
+	WriteHash(&header[16], key.source);
+	WriteLE32(&header[24], static_cast<uint32_t>(size));
+	WriteLE32(&header[28], Checksum(data, size));
+	WriteLE16(&header[32], sprites.isSheet() ? sprites.sheet().numLists() : 0);
+	WriteLE16(&header[34], palette != nullptr ? 1 : 0);
+
+	// Written to a temporary file first so that an interrupted write never leaves a truncated entry behind.
+	const std::string path = CachePath(key);
+	const std::string tempPath = StrCat(path, ".tmp");
+	FILE *file = OpenFile(tempPath.c_str(), "wb");
+	if (file == nullptr)
+		return;
+	bool success = std::fwrite(header, sizeof(header), 1, file) == 1
+	    && std::fwrite(data, size, 1, file) == 1;
+	if (success && palette != nullptr) {
+		uint8_t rgb[CachePaletteSize];
+		for (unsigned i = 0; i < 256; i++) {
+			rgb[i * 3] = palette[i].r;
+			rgb[i * 3 + 1] = palette[i].g;
+			rgb[i * 3 + 2] = palette[i].b;
+		}
+		success = std::fwrite(rgb, sizeof(rgb), 1, file) == 1;
+	}
+	success = std::fclose(file) == 0 && success;
+	if (!success) {
+		RemoveFile(tempPath.c_str());
+		return;
+	}
+	if (FileExists(path))
+		RemoveFile(path.c_str());
+	RenameFile(tempPath.c_str(), path.c_str());
+}
+
+} // namespace devilution
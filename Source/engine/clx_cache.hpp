@@ -0,0 +1,55 @@
+#pragma once
+
+#include <cstdint>
+
+#include <SDL.h>
+
+#include "engine/clx_sprite.hpp"
+#include "utils/pointer_value_union.hpp"
+#include "utils/stdcompat/optional.hpp"
+
+namespace devilution {
+
+/**
+ * @brief Identifies a converted sprite in the on-disk CLX cache.
+ *
+ * Each asset and set of conversion parameters maps to a single cache file,
+ * which is replaced when the archive the asset comes from changes.
+ */
+struct ClxCacheKey {
+	/** @brief Hash of the asset path and the conversion parameters, names the cache file. */
+	uint64_t entry;
+	/** @brief Hash of the archive and the asset's size in it, stored in the cache file to detect stale entries. */
+	uint64_t source;
+};
+
+#ifndef UNPACKED_MPQS
+/**
+ * @brief Returns the cache key for loading a CEL or CL2 file, or nullopt if it must not be cached.
+ *
+ * Only files from MPQ archives that are converted with a single frame width are cached.
+ */
+std::optional<ClxCacheKey> GetClxCacheKey(const char *path, PointerOrValue<uint16_t> widthOrWidths);
+
+/**
+ * @brief Returns the cache key for loading a PCX file, or nullopt if it must not be cached.
+ */
+std::optional<ClxCacheKey> GetClxCacheKey(const char *path, int numFramesOrFrameHeight, std::optional<uint8_t> transparentColor, bool withPalette);
+#endif
+
+/**
+ * @brief Loads a sprite list or sheet from the cache.
+ *
+ * @param outPalette Receives the palette stored with the sprite, if not null.
+ * @return nullopt if the entry is missing, stale or damaged.
+ */
+OptionalOwnedClxSpriteListOrSheet LoadCachedClx(const ClxCacheKey &key, SDL_Color *outPalette = nullptr);
+
+/**
+ * @brief Writes a converted sprite list or sheet to the cache, replacing any previous entry for `key`.
+ *
+ * @param palette Stored with the sprite if not null.
+ */
+void StoreCachedClx(const ClxCacheKey &key, ClxSpriteListOrSheet sprites, const SDL_Color *palette = nullptr);
+
+} // namespace devilution
@@ -1,7 +1,16 @@
 #include "engine/demomode.h"
 
+#include <algorithm>
+#include <chrono>
+#include <cmath>
 #include <cstdio>
 #include <deque>
+#include <iterator>
+#include <vector>
+
+#include <config.h>
+#include <fmt/format.h>
+#include <fmt/ranges.h>
 
 #ifdef USE_SDL1
 #include "utils/sdl2_to_1_2_backports.h"
@@ -9,11 +18,13 @@
 
 #include "controls/plrctrls.h"
 #include "engine/events.hpp"
+#include "engine/frame_pacing.hpp"
 #include "gmenu.h"
 #include "menu.h"
 #include "nthread.h"
 #include "options.h"
 #include "pfile.h"
+#include "statehash.h"
 #include "utils/display.h"
 #include "utils/endian_stream.hpp"
 #include "utils/paths.h"
@@ -66,10 +77,17 @@ struct DemoMsg {
 		MouseButtonEventData button;
 		MouseWheelEventData wheel;
 		KeyEventData key;
+		/** State before a `GameTick`, only present in demos of version 1 and later */
+		GameStateHash stateHash;
 	};
 };
 
+/** @brief Demos of version 1 store a `GameStateHash` with every game tick. */
+constexpr uint8_t DemoVersion = 1;
+
 int DemoNumber = -1;
+uint8_t PlaybackVersion;
+demo::StateDivergence Divergence;
 bool Timedemo = false;
 int RecordNumber = -1;
 bool CreateDemoReference = false;
@@ -84,6 +102,144 @@ int StartTime = 0;
 uint16_t DemoGraphicsWidth = 640;
 uint16_t DemoGraphicsHeight = 480;
 
+using BenchmarkClock = std::chrono::steady_clock;
+
+struct FrameTiming {
+	uint32_t logicMicroseconds;
+	uint32_t renderMicroseconds;
+	/** @brief Part of the render time spent presenting. */
+	uint32_t presentMicroseconds;
+};
+
+struct DurationStatistics {
+	uint32_t p50;
+	uint32_t p95;
+	uint32_t p99;
+	uint32_t max;
+	double mean;
+	double stddev;
+};
+
+std::string BenchmarkOutputPath;
+std::vector<FrameTiming> FrameTimings;
+BenchmarkClock::time_point LogicStartTime;
+BenchmarkClock::time_point RenderStartTime;
+BenchmarkClock::time_point BenchmarkStartTime;
+
+uint32_t MicrosecondsBetween(BenchmarkClock::time_point start, BenchmarkClock::time_point end)
+{
+	return static_cast<uint32_t>(std::chrono::duration_cast<std::chrono::microseconds>(end - start).count());
+}
+
+/**
+ * @brief Computes nearest-rank percentiles of the given durations.
+ * @param durations Will be sorted in place.
+ */
+DurationStatistics ComputeStatistics(std::vector<uint32_t> &durations)
+{
+	DurationStatistics stats {};
+	if (durations.empty())
+		return stats;
+	std::sort(durations.begin(), durations.end());
+	const auto percentile = [&](size_t p) {
+		const size_t rank = (durations.size() * p + 99) / 100;
+		return durations[std::max<size_t>(rank, 1) - 1];
+	};
+	stats.p50 = percentile(50);
+	stats.p95 = percentile(95);
+	stats.p99 = percentile(99);
+	stats.max = durations.back();
+	uint64_t total = 0;
+	for (uint32_t duration : durations)
+		total += duration;
+	stats.mean = static_cast<double>(total) / durations.size();
+	double squaredDeviations = 0;
+	for (uint32_t duration : durations)
+		squaredDeviations += (duration - stats.mean) * (duration - stats.mean);
+	stats.stddev = std::sqrt(squaredDeviations / durations.size());
+	return stats;
+}
+
+std::string FormatStatistics(const DurationStatistics &stats)
+{
+	return fmt::format(R"({{"p50_us": {}, "p95_us": {}, "p99_us": {}, "max_us": {}, "mean_us": {:.1f}, "stddev_us": {:.1f}}})",
+	    stats.p50, stats.p95, stats.p99, stats.max, stats.mean, stats.stddev);
+}
+
+/**
+ * @brief Mean difference between consecutive durations, which unlike the deviation is not raised by slow changes.
+ */
+double ComputeJitter(const std::vector<uint32_t> &durations)
+{
+	if (durations.size() < 2)
+		return 0;
+	uint64_t total = 0;
+	for (size_t i = 1; i < durations.size(); i++)
+		total += durations[i] > durations[i - 1] ? durations[i] - durations[i - 1] : durations[i - 1] - durations[i];
+	return static_cast<double>(total) / (durations.size() - 1);
+}
+
+void WriteBenchmarkReport(float seconds)
+{
+	std::vector<uint32_t> logic;
+	std::vector<uint32_t> render;
+	std::vector<uint32_t> present;
+	std::vector<uint32_t> frame;
+	logic.reserve(FrameTimings.size());
+	render.reserve(FrameTimings.size());
+	present.reserve(FrameTimings.size());
+	frame.reserve(FrameTimings.size());
+	for (const FrameTiming &timing : FrameTimings) {
+		logic.push_back(timing.logicMicroseconds);
+		render.push_back(timing.renderMicroseconds);
+		present.push_back(timing.presentMicroseconds);
+		frame.push_back(timing.logicMicroseconds + timing.renderMicroseconds);
+	}
+	const double frameJitter = ComputeJitter(frame);
+
+	// The per-frame values are written before the statistics sort the vectors.
+	const std::string perFrameLogic = fmt::format("{}", fmt::join(logic, ", "));
+	const std::string perFrameRender = fmt::format("{}", fmt::join(render, ", "));
+
+	const DurationStatistics logicStats = ComputeStatistics(logic);
+	const DurationStatistics renderStats = ComputeStatistics(render);
+	const DurationStatistics presentStats = ComputeStatistics(present);
+	const DurationStatistics frameStats = ComputeStatistics(frame);
+
+	// A hitch is a frame that would have missed the game tick on real hardware
+	// or that took more than twice as long as the median frame.
+	const uint32_t tickBudget = gnTickDelay * 1000;
+	const auto overTickBudget = std::count_if(frame.begin(), frame.end(), [&](uint32_t d) { return d > tickBudget; });
+	const auto overTwiceMedian = std::count_if(frame.begin(), frame.end(), [&](uint32_t d) { return d > frameStats.p50 * 2; });
+
+	FILE *report = OpenFile(BenchmarkOutputPath.c_str(), "wb");
+	if (report == nullptr) {
+		LogError("Failed to open {} for writing", BenchmarkOutputPath);
+		return;
+	}
+	std::string json = "{\n";
+	auto out = std::back_inserter(json);
+	fmt::format_to(out, "  \"version\": \"{}\",\n", PROJECT_VERSION);
+	fmt::format_to(out, "  \"demo\": {},\n", DemoNumber);
+	fmt::format_to(out, "  \"frames\": {},\n", FrameTimings.size());
+	fmt::format_to(out, "  \"seconds\": {:.3f},\n", seconds);
+	fmt::format_to(out, "  \"fps\": {:.1f},\n", seconds > 0 ? FrameTimings.size() / seconds : 0.0F);
+	fmt::format_to(out, "  \"tick_budget_us\": {},\n", tickBudget);
+	fmt::format_to(out, "  \"logic\": {},\n", FormatStatistics(logicStats));
+	fmt::format_to(out, "  \"render\": {},\n", FormatStatistics(renderStats));
+	fmt::format_to(out, "  \"present\": {},\n", FormatStatistics(presentStats));
+	fmt::format_to(out, "  \"frame\": {},\n", FormatStatistics(frameStats));
+	fmt::format_to(out, "  \"jitter_us\": {:.1f},\n", frameJitter);
+	fmt::format_to(out, "  \"hitches\": {{\"over_tick_budget\": {}, \"over_twice_median\": {}}},\n", overTickBudget, overTwiceMedian);
+	fmt::format_to(out, "  \"logic_us\": [{}],\n", perFrameLogic);
+	fmt::format_to(out, "  \"render_us\": [{}]\n", perFrameRender);
+	json += "}\n";
+	std::fwrite(json.data(), 1, json.size(), report);
+	std::fclose(report);
+	Log("Benchmark: frame p50 {}us p95 {}us p99 {}us max {}us, stddev {:.0f}us, jitter {:.0f}us, {} hitches, report written to {}",
+	    frameStats.p50, frameStats.p95, frameStats.p99, frameStats.max, frameStats.stddev, frameJitter, overTwiceMedian, BenchmarkOutputPath);
+}
+
 #if SDL_VERSION_ATLEAST(2, 0, 0)
 bool CreateSdlEvent(const DemoMsg &dmsg, SDL_Event &event, uint16_t &modState)
 {
@@ -287,9 +443,10 @@ bool LoadDemoMessages(int i)
 	}
 
 	const uint8_t version = ReadByte(demofile);
-	if (version != 0) {
+	if (version > DemoVersion) {
 		return false;
 	}
+	PlaybackVersion = version;
 
 	gSaveNumber = ReadLE32(demofile);
 	DemoGraphicsWidth = ReadLE16(demofile);
@@ -340,6 +497,18 @@ bool LoadDemoMessages(int i)
 			Demo_Message_Queue.push_back(msg);
 			break;
 		}
+		case DemoMsgType::GameTick: {
+			DemoMsg msg { type, progressToNextGameTick, 0, {} };
+			if (version >= 1) {
+				msg.stateHash.players = ReadLE32(demofile);
+				msg.stateHash.monsters = ReadLE32(demofile);
+				msg.stateHash.missiles = ReadLE32(demofile);
+				msg.stateHash.items = ReadLE32(demofile);
+				msg.stateHash.objects = ReadLE32(demofile);
+			}
+			Demo_Message_Queue.push_back(msg);
+			break;
+		}
 		default:
 			Demo_Message_Queue.push_back(DemoMsg { type, progressToNextGameTick, 0, {} });
 			break;
@@ -353,6 +522,36 @@ bool LoadDemoMessages(int i)
 	return true;
 }
 
+/**
+ * @brief Compares the current game state with the state recorded for the upcoming game tick and logs the first difference.
+ */
+void CheckStateHash(const GameStateHash &recorded)
+{
+	if (PlaybackVersion < 1 || Divergence.tick != -1)
+		return;
+
+	const GameStateHash current = ComputeGameStateHash();
+	if (current == recorded)
+		return;
+
+	Divergence.tick = LogicTick;
+	std::string details;
+	const auto addPart = [&details](string_view name, uint32_t recordedHash, uint32_t currentHash) {
+		if (recordedHash == currentHash)
+			return;
+		if (!Divergence.parts.empty())
+			Divergence.parts += ' ';
+		Divergence.parts.append(name.data(), name.size());
+		StrAppend(details, " ", name, " (", fmt::format("{:08x} != {:08x}", recordedHash, currentHash), ")");
+	};
+	addPart("players", recorded.players, current.players);
+	addPart("monsters", recorded.monsters, current.monsters);
+	addPart("missiles", recorded.missiles, current.missiles);
+	addPart("items", recorded.items, current.items);
+	addPart("objects", recorded.objects, current.objects);
+	LogError("Demo diverged from the recording before game tick {}:{}", LogicTick, details);
+}
+
 void RecordEventHeader(const SDL_Event &event)
 {
 	WriteLE32(DemoRecording, static_cast<uint32_t>(DemoMsgType::Message));
@@ -380,6 +579,10 @@ void InitRecording(int recordNumber, bool createDemoReference)
 	RecordNumber = recordNumber;
 	CreateDemoReference = createDemoReference;
 }
+void InitBenchmark(std::string outputPath)
+{
+	BenchmarkOutputPath = std::move(outputPath);
+}
 void OverrideOptions()
 {
 #ifndef USE_SDL1
@@ -407,6 +610,11 @@ bool IsRecording()
 	return RecordNumber != -1;
 }
 
+bool IsBenchmarking()
+{
+	return IsRunning() && !BenchmarkOutputPath.empty();
+}
+
 bool GetRunGameLoop(bool &drawGame, bool &processInput)
 {
 	if (Demo_Message_Queue.empty())
@@ -443,8 +651,10 @@ bool GetRunGameLoop(bool &drawGame, bool &processInput)
 	}
 	ProgressToNextGameTick = dmsg.progressToNextGameTick;
 	Demo_Message_Queue.pop_front();
-	if (dmsg.type == DemoMsgType::GameTick)
+	if (dmsg.type == DemoMsgType::GameTick) {
+		CheckStateHash(dmsg.stateHash);
 		LogicTick++;
+	}
 	return dmsg.type == DemoMsgType::GameTick;
 }
 
@@ -495,6 +705,14 @@ void RecordGameLoopResult(bool runGameLoop)
 {
 	WriteLE32(DemoRecording, static_cast<uint32_t>(runGameLoop ? DemoMsgType::GameTick : DemoMsgType::Rendering));
 	WriteByte(DemoRecording, ProgressToNextGameTick);
+	if (runGameLoop) {
+		const GameStateHash stateHash = ComputeGameStateHash();
+		WriteLE32(DemoRecording, stateHash.players);
+		WriteLE32(DemoRecording, stateHash.monsters);
+		WriteLE32(DemoRecording, stateHash.missiles);
+		WriteLE32(DemoRecording, stateHash.items);
+		WriteLE32(DemoRecording, stateHash.objects);
+	}
 }
 
 void RecordMessage(const SDL_Event &event, uint16_t modState)
@@ -563,8 +781,7 @@ void NotifyGameLoopStart()
 			LogError("Failed to open {} for writing", path);
 			return;
 		}
-		constexpr uint8_t Version = 0;
-		WriteByte(DemoRecording, Version);
+		WriteByte(DemoRecording, DemoVersion);
 		WriteLE32(DemoRecording, gSaveNumber);
 		WriteLE16(DemoRecording, gnScreenWidth);
 		WriteLE16(DemoRecording, gnScreenHeight);
@@ -573,11 +790,25 @@ void NotifyGameLoopStart()
 	if (IsRunning()) {
 		StartTime = SDL_GetTicks();
 		LogicTick = 0;
+		Divergence = {};
+	}
+
+	if (IsBenchmarking()) {
+		FrameTimings.clear();
+		TakePresentMicroseconds();
+		BenchmarkStartTime = BenchmarkClock::now();
 	}
 }
 
 void NotifyGameLoopEnd()
 {
+	if (IsBenchmarking()) {
+		const float seconds = MicrosecondsBetween(BenchmarkStartTime, BenchmarkClock::now()) / 1000000.0F;
+		WriteBenchmarkReport(seconds);
+		BenchmarkOutputPath.clear();
+		FrameTimings.clear();
+	}
+
 	if (IsRecording()) {
 		std::fclose(DemoRecording);
 		DemoRecording = nullptr;
@@ -588,6 +819,11 @@ void NotifyGameLoopEnd()
 		CreateDemoReference = false;
 	}
 
+	if (IsRunning() && HeadlessMode) {
+		const float seconds = (SDL_GetTicks() - StartTime) / 1000.0f;
+		SDL_Log("%d ticks, %.2f seconds: %.1f ticks per second", LogicTick, seconds, LogicTick / seconds);
+	}
+
 	if (IsRunning() && !HeadlessMode) {
 		float seconds = (SDL_GetTicks() - StartTime) / 1000.0f;
 		SDL_Log("%d frames, %.2f seconds: %.1f fps", LogicTick, seconds, LogicTick / seconds);
@@ -609,6 +845,33 @@ void NotifyGameLoopEnd()
 	}
 }
 
+const StateDivergence &GetStateDivergence()
+{
+	return Divergence;
+}
+
+void NotifyLogicStart()
+{
+	if (!IsBenchmarking())
+		return;
+	LogicStartTime = BenchmarkClock::now();
+}
+
+void NotifyRenderStart()
+{
+	if (!IsBenchmarking())
+		return;
+	RenderStartTime = BenchmarkClock::now();
+}
+
+void NotifyFrameEnd()
+{
+	if (!IsBenchmarking())
+		return;
+	const BenchmarkClock::time_point frameEndTime = BenchmarkClock::now();
+	FrameTimings.push_back({ MicrosecondsBetween(LogicStartTime, RenderStartTime), MicrosecondsBetween(RenderStartTime, frameEndTime), TakePresentMicroseconds() });
+}
+
 } // namespace demo
 
 } // namespace devilution
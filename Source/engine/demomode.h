@@ -5,6 +5,8 @@
  */
 #pragma once
 
+#include <string>
+
 #include <SDL.h>
 
 namespace devilution {
@@ -12,12 +14,28 @@ namespace devilution {
 namespace demo {
 
 #ifndef DISABLE_DEMOMODE
+/**
+ * @brief Where the playback of a demo first diverged from the game state recorded in it.
+ */
+struct StateDivergence {
+	/** @brief Game tick before which the state differed, -1 if the playback has not diverged. */
+	int tick = -1;
+	/** @brief Names of the parts of the state that differed, separated by spaces, e.g. "monsters missiles". */
+	std::string parts;
+};
+
 void InitPlayBack(int demoNumber, bool timedemo);
 void InitRecording(int recordNumber, bool createDemoReference);
+/**
+ * @brief Collects per-frame logic and render durations during playback and writes a JSON report when the demo ends.
+ * @param outputPath Where the report is written.
+ */
+void InitBenchmark(std::string outputPath);
 void OverrideOptions();
 
 bool IsRunning();
 bool IsRecording();
+bool IsBenchmarking();
 
 bool GetRunGameLoop(bool &drawGame, bool &processInput);
 bool FetchMessage(SDL_Event *event, uint16_t *modState);
@@ -26,6 +44,18 @@ void RecordMessage(const SDL_Event &event, uint16_t modState);
 
 void NotifyGameLoopStart();
 void NotifyGameLoopEnd();
+
+/**
+ * @brief Returns where the current playback diverged, only checked for demos of version 1 and later.
+ */
+const StateDivergence &GetStateDivergence();
+
+/** @brief Marks the start of game logic processing for the current frame. */
+void NotifyLogicStart();
+/** @brief Marks the end of game logic and the start of rendering for the current frame. */
+void NotifyRenderStart();
+/** @brief Marks the end of the current frame and stores its timings. */
+void NotifyFrameEnd();
 #else
 inline void OverrideOptions()
 {
@@ -38,6 +68,10 @@ inline bool IsRecording()
 {
 	return false;
 }
+inline bool IsBenchmarking()
+{
+	return false;
+}
 inline bool GetRunGameLoop(bool &, bool &)
 {
 	return false;
@@ -58,6 +92,15 @@ inline void NotifyGameLoopStart()
 inline void NotifyGameLoopEnd()
 {
 }
+inline void NotifyLogicStart()
+{
+}
+inline void NotifyRenderStart()
+{
+}
+inline void NotifyFrameEnd()
+{
+}
 #endif
 
 } // namespace demo
@@ -7,8 +7,10 @@
 
 #include <SDL.h>
 
+#include "controls/input.h"
 #include "controls/plrctrls.h"
 #include "engine.h"
+#include "engine/frame_pacing.hpp"
 #include "options.h"
 #include "utils/display.h"
 #include "utils/log.hpp"
@@ -64,23 +66,6 @@ bool CanRenderDirectlyToOutputSurface()
 #endif
 }
 
-/**
- * @brief Limit FPS to avoid high CPU load, use when v-sync isn't available
- */
-void LimitFrameRate()
-{
-	if (!*sgOptions.Graphics.limitFPS)
-		return;
-	static uint32_t frameDeadline;
-	uint32_t tc = SDL_GetTicks() * 1000;
-	uint32_t v = 0;
-	if (frameDeadline > tc) {
-		v = tc % refreshDelay;
-		SDL_Delay(v / 1000 + 1); // ceil
-	}
-	frameDeadline = tc + v + refreshDelay;
-}
-
 } // namespace
 
 void dx_init()
@@ -219,7 +204,7 @@ void RenderPresent()
 	SDL_Surface *surface = GetOutputSurface();
 
 	if (!gbActive) {
-		LimitFrameRate();
+		PaceFrameEnd();
 		return;
 	}
 
@@ -243,27 +228,37 @@ void RenderPresent()
 		if (ControlMode == ControlTypes::VirtualGamepad) {
 			RenderVirtualGamepad(renderer);
 		}
+		NotifyPresentStart();
 		SDL_RenderPresent(renderer);
+		NotifyPresentEnd();
+		NotifyFramePresented();
 
+		// With v-sync the present already waits for the display.
 		if (!*sgOptions.Graphics.vSync) {
-			LimitFrameRate();
+			PaceFrameEnd();
 		}
 	} else {
 		if (ControlMode == ControlTypes::VirtualGamepad) {
 			RenderVirtualGamepad(surface);
 		}
+		NotifyPresentStart();
 		if (SDL_UpdateWindowSurface(ghMainWnd) <= -1) {
 			ErrSdl();
 		}
-		LimitFrameRate();
+		NotifyPresentEnd();
+		NotifyFramePresented();
+		PaceFrameEnd();
 	}
 #else
+	NotifyPresentStart();
 	if (SDL_Flip(surface) <= -1) {
 		ErrSdl();
 	}
+	NotifyPresentEnd();
+	NotifyFramePresented();
 	if (RenderDirectlyToOutputSurface)
 		PalSurface = GetOutputSurface();
-	LimitFrameRate();
+	PaceFrameEnd();
 #endif
 }
 
@@ -0,0 +1,157 @@
+#include "engine/frame_pacing.hpp"
+
+#include <algorithm>
+
+#include <SDL.h>
+
+#include "options.h"
+#include "utils/display.h"
+
+namespace devilution {
+
+namespace {
+
+/** @brief Limits how long a wait spins when the system is slow to wake up from a sleep. */
+constexpr int64_t MaxSpinMicroseconds = 4000;
+
+/**
+ * @brief Follows increases of `estimate` immediately and decreases slowly, so that a single quick sample does not
+ * cause the next frames to miss their deadline.
+ */
+int64_t UpdateEstimate(int64_t estimate, int64_t sample)
+{
+	if (sample >= estimate)
+		return sample;
+	return estimate - (estimate - sample) / 16;
+}
+
+int64_t SdlNow()
+{
+#ifdef USE_SDL1
+	// SDL 1 has no high resolution counter, the overshoot estimate absorbs the coarser readings.
+	return static_cast<int64_t>(SDL_GetTicks()) * 1000;
+#else
+	static const uint64_t Frequency = SDL_GetPerformanceFrequency();
+	const uint64_t counter = SDL_GetPerformanceCounter();
+	// Split to avoid overflowing with nanosecond counters.
+	return static_cast<int64_t>(counter / Frequency * 1000000 + counter % Frequency * 1000000 / Frequency);
+#endif
+}
+
+void SdlSleep(uint32_t milliseconds)
+{
+	SDL_Delay(milliseconds);
+}
+
+FramePacer DisplayFramePacer { FramePacer::Clock { SdlNow, SdlSleep } };
+
+/**
+ * @brief Whether presenting a frame returns before it is shown, otherwise the present itself paces the frames.
+ */
+bool IsPresentNonBlocking()
+{
+#ifndef USE_SDL1
+	if (renderer != nullptr && *sgOptions.Graphics.vSync)
+		return false;
+#endif
+	return true;
+}
+
+} // namespace
+
+void FramePacer::beginFrame()
+{
+	if (!lowLatency_)
+		return;
+
+	const int64_t now = clock_.now();
+	// A frame that was not presented keeps its deadline.
+	if (!framePaced_)
+		advanceDeadline(now + frameCost_);
+	waitUntil(deadline_ - frameCost_);
+	frameStart_ = clock_.now();
+	framePaced_ = true;
+}
+
+void FramePacer::beginPresent()
+{
+	presentStart_ = clock_.now();
+}
+
+void FramePacer::endPresent()
+{
+	presentDuration_ += clock_.now() - presentStart_;
+}
+
+void FramePacer::endFrame()
+{
+	const int64_t now = clock_.now();
+	if (framePaced_) {
+		frameCost_ = std::min(UpdateEstimate(frameCost_, now - frameStart_), period_);
+		framePaced_ = false;
+		return;
+	}
+
+	advanceDeadline(now);
+	waitUntil(deadline_);
+}
+
+void FramePacer::advanceDeadline(int64_t now)
+{
+	deadline_ += period_;
+	// Rather than rushing to catch up after a slow frame, or waiting out a deadline set for a longer period,
+	// the schedule starts over.
+	if (deadline_ < now - period_ || deadline_ > now + period_)
+		deadline_ = now;
+}
+
+void FramePacer::waitUntil(int64_t deadline)
+{
+	while (true) {
+		const int64_t now = clock_.now();
+		const int64_t remaining = deadline - now;
+		if (remaining <= 0)
+			return;
+		if (remaining <= sleepOvershoot_ + 1000)
+			continue;
+
+		const auto milliseconds = static_cast<uint32_t>((remaining - sleepOvershoot_) / 1000);
+		clock_.sleep(milliseconds);
+		const int64_t overshoot = clock_.now() - now - static_cast<int64_t>(milliseconds) * 1000;
+		sleepOvershoot_ = std::clamp<int64_t>(UpdateEstimate(sleepOvershoot_, overshoot), 0, MaxSpinMicroseconds);
+	}
+}
+
+void PaceFrameStart()
+{
+	if (!*sgOptions.Graphics.limitFPS)
+		return;
+	DisplayFramePacer.setPeriod(refreshDelay);
+	DisplayFramePacer.setLowLatency(*sgOptions.Graphics.lowLatencyPacing && IsPresentNonBlocking());
+	DisplayFramePacer.beginFrame();
+}
+
+void PaceFrameEnd()
+{
+	if (!*sgOptions.Graphics.limitFPS)
+		return;
+	DisplayFramePacer.setPeriod(refreshDelay);
+	DisplayFramePacer.endFrame();
+}
+
+void NotifyPresentStart()
+{
+	DisplayFramePacer.beginPresent();
+}
+
+void NotifyPresentEnd()
+{
+	DisplayFramePacer.endPresent();
+}
+
+uint32_t TakePresentMicroseconds()
+{
+	return static_cast<uint32_t>(DisplayFramePacer.takePresentDuration());
+}
+
+} // namespace devilution
@@ -0,0 +1,109 @@
+#pragma once
+
+#include <cstdint>
+
+namespace devilution {
+
+/**
+ * @brief Spaces out presented frames by a fixed period.
+ *
+ * Waits sleep for most of the time and spin for the rest, which avoids the millisecond granularity of sleeping
+ * without keeping a core busy for the whole frame. How much earlier than the deadline a sleep has to end adapts to
+ * how late the system wakes up.
+ */
+class FramePacer {
+public:
+	struct Clock {
+		/** @brief Monotonic time in microseconds. */
+		int64_t (*now)();
+		void (*sleep)(uint32_t milliseconds);
+	};
+
+	explicit FramePacer(Clock clock)
+	    : clock_(clock)
+	{
+	}
+
+	void setPeriod(int64_t microseconds)
+	{
+		period_ = microseconds;
+	}
+
+	/**
+	 * @brief Waits before the frame rather than after it, so that it reads input as close to its present as possible.
+	 */
+	void setLowLatency(bool lowLatency)
+	{
+		lowLatency_ = lowLatency;
+	}
+
+	/**
+	 * @brief Called before the input of a frame is read.
+	 *
+	 * In low latency mode, waits until the predicted cost of the frame fits just before its present deadline.
+	 */
+	void beginFrame();
+
+	void beginPresent();
+	void endPresent();
+
+	/**
+	 * @brief Called after a frame was presented or skipped, waits until the next frame is due.
+	 *
+	 * Does not wait in low latency mode when `beginFrame` already waited for this frame.
+	 */
+	void endFrame();
+
+	/** @brief Time spent presenting since the previous call. */
+	int64_t takePresentDuration()
+	{
+		const int64_t duration = presentDuration_;
+		presentDuration_ = 0;
+		return duration;
+	}
+
+	/** @brief Predicted time from the start of a frame until its present finishes. */
+	[[nodiscard]] int64_t predictedFrameCost() const
+	{
+		return frameCost_;
+	}
+
+private:
+	/** @brief Moves the deadline to the next frame, or to `now` if the schedule is more than a frame off. */
+	void advanceDeadline(int64_t now);
+	void waitUntil(int64_t deadline);
+
+	Clock clock_;
+	int64_t period_ = 16667;
+	bool lowLatency_ = false;
+	int64_t deadline_ = 0;
+	/** @brief How much later than requested a sleep ends, sleeps end this much before the deadline. */
+	int64_t sleepOvershoot_ = 1000;
+	int64_t frameStart_ = 0;
+	/** @brief Whether `beginFrame` waited for the current frame. */
+	bool framePaced_ = false;
+	int64_t frameCost_ = 0;
+	int64_t presentStart_ = 0;
+	int64_t presentDuration_ = 0;
+};
+
+/**
+ * @brief Called by the game loop before it reads the input of a frame.
+ */
+void PaceFrameStart();
+
+/**
+ * @brief Called after a frame was presented or skipped, waits until the next frame is due when the FPS Limiter is on.
+ */
+void PaceFrameEnd();
+
+/**
+ * @brief Brackets the present call so that its duration is measured.
+ */
+void NotifyPresentStart();
+void NotifyPresentEnd();
+
+/** @brief Microseconds spent presenting since the previous call. */
+uint32_t TakePresentMicroseconds();
+
+} // namespace devilution
@@ -0,0 +1,286 @@
+#include "engine/level_prefetch.hpp"
+
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "diablo.h"
+#include "engine/assets.hpp"
+#include "engine/palette.h"
+#include "utils/log.hpp"
+#include "utils/sdl_cond.h"
+#include "utils/sdl_mutex.h"
+#include "utils/sdl_thread.h"
+#include "utils/stdcompat/optional.hpp"
+#include "utils/stdcompat/string_view.hpp"
+#include "utils/str_cat.hpp"
+
+#ifndef UNPACKED_MPQS
+#include "utils/cel_to_clx.hpp"
+#endif
+
+namespace devilution {
+
+namespace {
+
+enum class PrefetchKind : uint8_t {
+	File,
+	Cel,
+	BlendedLookupTable,
+};
+
+struct PrefetchJob {
+	PrefetchKind kind;
+	std::string path;
+	/** @brief Frame width of a CEL file. */
+	uint16_t width = 0;
+
+	/** @brief Whether the background thread is done with the job, guarded by the prefetcher's mutex. */
+	bool done = false;
+	/** @brief Whether the main thread took the result. */
+	bool taken = false;
+
+	std::unique_ptr<byte[]> data;
+	size_t size = 0;
+	OptionalOwnedClxSpriteList sprites;
+	std::unique_ptr<Uint8[][256]> table;
+};
+
+std::unique_ptr<byte[]> ReadAsset(const char *path, size_t &size)
+{
+	AssetHandle handle = OpenAsset(path, size, /*threadsafe=*/true);
+	if (!handle.ok())
+		return nullptr;
+	std::unique_ptr<byte[]> data { new byte[size] };
+	if (!handle.read(data.get(), size))
+		return nullptr;
+	return data;
+}
+
+void RunJob(PrefetchJob &job, dungeon_type type)
+{
+	switch (job.kind) {
+	case PrefetchKind::File:
+		job.data = ReadAsset(job.path.c_str(), job.size);
+		break;
+	case PrefetchKind::Cel: {
+#ifndef UNPACKED_MPQS
+		size_t size;
+		const std::unique_ptr<byte[]> data = ReadAsset(StrCat(job.path, DEVILUTIONX_CEL_EXT).c_str(), size);
+		if (data != nullptr)
+			job.sprites = CelToClx(reinterpret_cast<const uint8_t *>(data.get()), size, PointerOrValue<uint16_t> { job.width }).list();
+#endif
+	} break;
+	case PrefetchKind::BlendedLookupTable: {
+		size_t size;
+		const std::unique_ptr<byte[]> data = ReadAsset(job.path.c_str(), size);
+		if (data == nullptr || size < 256 * 3)
+			break;
+		SDL_Color palette[256];
+		for (unsigned i = 0; i < 256; i++) {
+			palette[i].r = static_cast<Uint8>(data[i * 3]);
+			palette[i].g = static_cast<Uint8>(data[i * 3 + 1]);
+			palette[i].b = static_cast<Uint8>(data[i * 3 + 2]);
+		}
+		job.table.reset(new Uint8[256][256]);
+		GenerateBlendedLookupTable(palette, type, job.table.get());
+	} break;
+	}
+}
+
+/**
+ * @brief Runs the prefetch jobs of a level, in order, on a background thread.
+ */
+class LevelPrefetcher {
+public:
+	LevelPrefetcher(dungeon_type type, std::vector<PrefetchJob> &&jobs)
+	    : type_(type)
+	    , jobs_(std::move(jobs))
+	    , thread_(ThreadMain, this)
+	{
+	}
+
+	/**
+	 * @brief Skips the jobs that have not started yet and waits for the current one.
+	 */
+	~LevelPrefetcher()
+	{
+		mutex_.lock();
+		quit_ = true;
+		mutex_.unlock();
+		thread_.join();
+	}
+
+	LevelPrefetcher(const LevelPrefetcher &) = delete;
+	LevelPrefetcher &operator=(const LevelPrefetcher &) = delete;
+
+	[[nodiscard]] dungeon_type type() const
+	{
+		return type_;
+	}
+
+	/** @brief Time the main thread spent waiting for jobs. */
+	[[nodiscard]] uint32_t waitedMilliseconds() const
+	{
+		return waited_;
+	}
+
+	/**
+	 * @brief Returns the job for `path`, waiting for the background thread to finish it.
+	 * @return nullptr if there is no such job, or it was already taken.
+	 */
+	PrefetchJob *take(PrefetchKind kind, string_view path)
+	{
+		for (PrefetchJob &job : jobs_) {
+			if (job.taken || job.kind != kind || job.path != path)
+				continue;
+			const uint32_t waitStart = SDL_GetTicks();
+			mutex_.lock();
+			while (!job.done)
+				jobDone_.wait(mutex_);
+			mutex_.unlock();
+			waited_ += SDL_GetTicks() - waitStart;
+			job.taken = true;
+			return &job;
+		}
+		return nullptr;
+	}
+
+private:
+	static int SDLCALL ThreadMain(void *data);
+
+	dungeon_type type_;
+	std::vector<PrefetchJob> jobs_;
+	uint32_t waited_ = 0;
+	SdlMutex mutex_;
+	SdlCond jobDone_;
+	bool quit_ = false;
+	// Declared last so that the thread starts once everything else is initialized.
+	SdlThread thread_;
+};
+
+int SDLCALL LevelPrefetcher::ThreadMain(void *data)
+{
+	auto &prefetcher = *static_cast<LevelPrefetcher *>(data);
+	for (PrefetchJob &job : prefetcher.jobs_) {
+		prefetcher.mutex_.lock();
+		const bool quit = prefetcher.quit_;
+		prefetcher.mutex_.unlock();
+		if (quit)
+			break;
+
+		RunJob(job, prefetcher.type_);
+
+		prefetcher.mutex_.lock();
+		job.done = true;
+		prefetcher.jobDone_.signal();
+		prefetcher.mutex_.unlock();
+	}
+	return 0;
+}
+
+struct TransitionStats {
+	uint32_t count;
+	uint32_t totalMilliseconds;
+	uint32_t maxMilliseconds;
+};
+
+const char *const DungeonTypeNames[] = { "town", "cathedral", "catacombs", "caves", "hell", "nest", "crypt" };
+
+std::unique_ptr<LevelPrefetcher> Prefetcher;
+/** @brief SDL_GetTicks() when the current level transition started. */
+std::optional<uint32_t> TransitionStart;
+TransitionStats Transitions[DTYPE_LAST + 1];
+
+PrefetchJob MakeJob(PrefetchKind kind, std::string path, uint16_t width = 0)
+{
+	PrefetchJob job;
+	job.kind = kind;
+	job.path = std::move(path);
+	job.width = width;
+	return job;
+}
+
+} // namespace
+
+void StartLevelPrefetch(dungeon_type type)
+{
+	Prefetcher = nullptr;
+	TransitionStart = SDL_GetTicks();
+	if (type < DTYPE_TOWN || type > DTYPE_LAST)
+		return;
+
+	const TilesetPaths paths = GetTilesetPaths(type);
+	std::vector<PrefetchJob> jobs;
+	// In the order LoadGameLevel needs them, so that the main thread rarely has to wait.
+	jobs.push_back(MakeJob(PrefetchKind::File, paths.min));
+	jobs.push_back(MakeJob(PrefetchKind::File, paths.cel));
+	jobs.push_back(MakeJob(PrefetchKind::File, paths.til));
+#ifndef UNPACKED_MPQS
+	jobs.push_back(MakeJob(PrefetchKind::Cel, paths.specialCel, SpecialCelWidth));
+#endif
+	jobs.push_back(MakeJob(PrefetchKind::File, paths.sol));
+	if (!HeadlessMode) {
+		// The palette is rolled after the dungeon is generated, so the tables are generated for every candidate.
+		for (int number = 1; number <= NumLevelPalettes; number++) {
+			std::string path = GetLevelPalettePath(type, number);
+			if (jobs.back().path == path)
+				break;
+			jobs.push_back(MakeJob(PrefetchKind::BlendedLookupTable, std::move(path)));
+		}
+	}
+	Prefetcher = std::make_unique<LevelPrefetcher>(type, std::move(jobs));
+}
+
+std::unique_ptr<byte[]> TakePrefetchedFile(const char *path, size_t &size)
+{
+	if (Prefetcher == nullptr)
+		return nullptr;
+	PrefetchJob *job = Prefetcher->take(PrefetchKind::File, path);
+	if (job == nullptr)
+		return nullptr;
+	size = job->size;
+	return std::move(job->data);
+}
+
+OptionalOwnedClxSpriteList TakePrefetchedCel(const char *name, uint16_t width)
+{
+	if (Prefetcher == nullptr)
+		return std::nullopt;
+	PrefetchJob *job = Prefetcher->take(PrefetchKind::Cel, name);
+	if (job == nullptr || job->width != width)
+		return std::nullopt;
+	return std::move(job->sprites);
+}
+
+bool TakePrefetchedBlendedLookupTable(const char *palettePath, dungeon_type type, Uint8 (*table)[256])
+{
+	if (Prefetcher == nullptr || Prefetcher->type() != type)
+		return false;
+	PrefetchJob *job = Prefetcher->take(PrefetchKind::BlendedLookupTable, palettePath);
+	if (job == nullptr || job->table == nullptr)
+		return false;
+	memcpy(table, job->table.get(), sizeof(Uint8[256][256]));
+	return true;
+}
+
+void EndLevelPrefetch()
+{
+	const uint32_t waited = Prefetcher != nullptr ? Prefetcher->waitedMilliseconds() : 0;
+	Prefetcher = nullptr;
+	if (!TransitionStart)
+		return;
+	const uint32_t elapsed = SDL_GetTicks() - *TransitionStart;
+	TransitionStart = std::nullopt;
+	if (leveltype < DTYPE_TOWN || leveltype > DTYPE_LAST)
+		return;
+
+	TransitionStats &stats = Transitions[leveltype];
+	stats.count++;
+	stats.totalMilliseconds += elapsed;
+	stats.maxMilliseconds = std::max(stats.maxMilliseconds, elapsed);
+	LogVerbose("Transition to {} took {} ms, {} ms of it waiting for prefetched assets. {} transitions: average {} ms, max {} ms",
+	    DungeonTypeNames[leveltype], elapsed, waited, stats.count, stats.totalMilliseconds / stats.count, stats.maxMilliseconds);
+}
+
+} // namespace devilution
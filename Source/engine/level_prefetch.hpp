@@ -0,0 +1,104 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <type_traits>
+
+#include <SDL.h>
+
+#include "engine/clx_sprite.hpp"
+#include "engine/load_cel.hpp"
+#include "engine/load_file.hpp"
+#include "levels/gendung.h"
+#include "utils/stdcompat/cstddef.hpp"
+
+namespace devilution {
+
+/**
+ * @brief Starts reading the assets of a level of the given type on a background thread.
+ *
+ * Called as soon as a level transition starts, so that reading the tileset, converting its sprites and generating the
+ * transparency tables of the palettes it may roll overlap with fading out, saving the previous level and generating
+ * the new one. The background thread only reads assets, the game state is left to the main thread.
+ *
+ * With `DTYPE_NONE` nothing is prefetched, only the time the transition takes is measured.
+ */
+void StartLevelPrefetch(dungeon_type type);
+
+/**
+ * @brief Takes the contents of a prefetched file, waiting for it to be read if necessary.
+ * @return nullptr if the file is not prefetched or could not be read.
+ */
+std::unique_ptr<byte[]> TakePrefetchedFile(const char *path, size_t &size);
+
+/**
+ * @brief Takes the sprites converted from a prefetched CEL file, waiting for them if necessary.
+ * @param name Path without the file extension, as passed to `LoadCel`.
+ */
+OptionalOwnedClxSpriteList TakePrefetchedCel(const char *name, uint16_t width);
+
+/**
+ * @brief Copies the transparency table generated for a palette on a level of the given type into `table`.
+ * @return false if the table is not prefetched.
+ */
+bool TakePrefetchedBlendedLookupTable(const char *palettePath, dungeon_type type, Uint8 (*table)[256]);
+
+/**
+ * @brief Stops the background thread, frees any prefetched assets that were not taken and logs how long the
+ * transition to the current level took.
+ */
+void EndLevelPrefetch();
+
+/**
+ * @brief Same as `LoadFileInMem`, but takes the file from the level prefetch if it is there.
+ */
+template <typename T = byte>
+std::unique_ptr<T[]> LoadPrefetchedFileInMem(const char *path, std::size_t *numRead = nullptr)
+{
+	size_t size;
+	std::unique_ptr<byte[]> data = TakePrefetchedFile(path, size);
+	if (data == nullptr)
+		return LoadFileInMem<T>(path, numRead);
+	if ((size % sizeof(T)) != 0)
+		app_fatal(StrCat("File size does not align with type\n", path));
+
+	if (numRead != nullptr)
+		*numRead = size / sizeof(T);
+
+	if constexpr (std::is_same_v<T, byte>) {
+		return data;
+	} else {
+		std::unique_ptr<T[]> buf { new T[size / sizeof(T)] };
+		memcpy(buf.get(), data.get(), size);
+		return buf;
+	}
+}
+
+template <typename T, std::size_t N>
+void LoadPrefetchedFileInMem(const char *path, std::array<T, N> &data)
+{
+	size_t size;
+	std::unique_ptr<byte[]> prefetched = TakePrefetchedFile(path, size);
+	if (prefetched == nullptr) {
+		LoadFileInMem(path, data);
+		return;
+	}
+	memcpy(data.data(), prefetched.get(), std::min(size, N * sizeof(T)));
+}
+
+/**
+ * @brief Same as `LoadCel`, but takes the sprites from the level prefetch if they are there.
+ */
+inline OwnedClxSpriteList LoadPrefetchedCel(const char *name, uint16_t width)
+{
+	OptionalOwnedClxSpriteList sprites = TakePrefetchedCel(name, width);
+	if (sprites)
+		return std::move(*sprites);
+	return LoadCel(name, width);
+}
+
+} // namespace devilution
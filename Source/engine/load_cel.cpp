@@ -10,6 +10,7 @@
 #ifdef UNPACKED_MPQS
 #include "engine/load_clx.hpp"
 #else
+#include "engine/clx_cache.hpp"
 #include "engine/load_file.hpp"
 #include "utils/cel_to_clx.hpp"
 #endif
@@ -23,12 +24,21 @@ OwnedClxSpriteListOrSheet LoadCelListOrSheet(const char *pszName, PointerOrValue
 #ifdef UNPACKED_MPQS
 	return LoadClxListOrSheet(path);
 #else
+	const std::optional<ClxCacheKey> cacheKey = GetClxCacheKey(path, widthOrWidths);
+	if (cacheKey) {
+		OptionalOwnedClxSpriteListOrSheet cached = LoadCachedClx(*cacheKey);
+		if (cached)
+			return std::move(*cached);
+	}
 	size_t size;
 	std::unique_ptr<uint8_t[]> data = LoadFileInMem<uint8_t>(path, &size);
 #ifdef DEBUG_CEL_TO_CL2_SIZE
 	std::cout << path;
 #endif
-	return CelToClx(data.get(), size, widthOrWidths);
+	OwnedClxSpriteListOrSheet result = CelToClx(data.get(), size, widthOrWidths);
+	if (cacheKey)
+		StoreCachedClx(*cacheKey, result);
+	return result;
 #endif
 }
 
@@ -9,6 +9,7 @@
 #ifdef UNPACKED_MPQS
 #include "engine/load_clx.hpp"
 #else
+#include "engine/clx_cache.hpp"
 #include "engine/load_file.hpp"
 #include "utils/cl2_to_clx.hpp"
 #endif
@@ -22,9 +23,18 @@ OwnedClxSpriteListOrSheet LoadCl2ListOrSheet(const char *pszName, PointerOrValue
 #ifdef UNPACKED_MPQS
 	return LoadClxListOrSheet(path);
 #else
+	const std::optional<ClxCacheKey> cacheKey = GetClxCacheKey(path, widthOrWidths);
+	if (cacheKey) {
+		OptionalOwnedClxSpriteListOrSheet cached = LoadCachedClx(*cacheKey);
+		if (cached)
+			return std::move(*cached);
+	}
 	size_t size;
 	std::unique_ptr<uint8_t[]> data = LoadFileInMem<uint8_t>(path, &size);
-	return Cl2ToClx(std::move(data), size, widthOrWidths);
+	OwnedClxSpriteListOrSheet result = Cl2ToClx(std::move(data), size, widthOrWidths);
+	if (cacheKey)
+		StoreCachedClx(*cacheKey, result);
+	return result;
 #endif
 }
 
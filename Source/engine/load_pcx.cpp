@@ -20,6 +20,7 @@
 #include "engine/load_file.hpp"
 #else
 #include "engine/assets.hpp"
+#include "engine/clx_cache.hpp"
 #include "utils/pcx.hpp"
 #include "utils/pcx_to_clx.hpp"
 #endif
@@ -57,6 +58,12 @@ OptionalOwnedClxSpriteList LoadPcxSpriteList(const char *filename, int numFrames
 	}
 	return result;
 #else
+	const std::optional<ClxCacheKey> cacheKey = GetClxCacheKey(path, numFramesOrFrameHeight, transparentColor, outPalette != nullptr);
+	if (cacheKey) {
+		OptionalOwnedClxSpriteListOrSheet cached = LoadCachedClx(*cacheKey, outPalette);
+		if (cached)
+			return std::move(*cached).list();
+	}
 	size_t fileSize;
 	AssetHandle handle = OpenAsset(path, fileSize);
 	if (!handle.ok()) {
@@ -70,6 +77,8 @@ OptionalOwnedClxSpriteList LoadPcxSpriteList(const char *filename, int numFrames
 	OptionalOwnedClxSpriteList result = PcxToClx(handle, fileSize, numFramesOrFrameHeight, transparentColor, outPalette);
 	if (!result)
 		return std::nullopt;
+	if (cacheKey)
+		StoreCachedClx(*cacheKey, ClxSpriteListOrSheet { ClxSpriteList { *result }.data(), 0 }, outPalette);
 	return result;
 #endif
 }
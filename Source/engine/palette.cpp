@@ -10,6 +10,7 @@
 #include "engine/backbuffer_state.hpp"
 #include "engine/demomode.h"
 #include "engine/dx.h"
+#include "engine/level_prefetch.hpp"
 #include "engine/load_file.hpp"
 #include "engine/random.hpp"
 #include "hwcursor.hpp"
@@ -41,7 +42,7 @@ void LoadGamma()
 	sgOptions.Graphics.gammaCorrection.SetValue(gammaValue - gammaValue % 5);
 }
 
-Uint8 FindBestMatchForColor(SDL_Color *palette, SDL_Color color, int skipFrom, int skipTo)
+Uint8 FindBestMatchForColor(const SDL_Color *palette, SDL_Color color, int skipFrom, int skipTo)
 {
 	Uint8 best;
 	Uint32 bestDiff = SDL_MAX_UINT32;
@@ -72,21 +73,18 @@ Uint8 FindBestMatchForColor(SDL_Color *palette, SDL_Color color, int skipFrom, i
  * @param palette The colors to operate on
  * @param skipFrom Do not use colors between this index and skipTo
  * @param skipTo Do not use colors between skipFrom and this index
- * @param toUpdate Only update the first n colors
+ * @param table Receives the blended colors
  */
-void GenerateBlendedLookupTable(SDL_Color *palette, int skipFrom, int skipTo, int toUpdate = 256)
+void GenerateBlendedLookupTable(const SDL_Color *palette, int skipFrom, int skipTo, Uint8 (*table)[256])
 {
 	for (int i = 0; i < 256; i++) {
 		for (int j = 0; j < 256; j++) {
 			if (i == j) { // No need to calculate transparency between 2 identical colors
-				paletteTransparencyLookup[i][j] = j;
+				table[i][j] = j;
 				continue;
 			}
 			if (i > j) { // Half the blends will be mirror identical ([i][j] is the same as [j][i]), so simply copy the existing combination.
-				paletteTransparencyLookup[i][j] = paletteTransparencyLookup[j][i];
-				continue;
-			}
-			if (i > toUpdate && j > toUpdate) {
+				table[i][j] = table[j][i];
 				continue;
 			}
 
@@ -95,10 +93,13 @@ void GenerateBlendedLookupTable(SDL_Color *palette, int skipFrom, int skipTo, in
 			blendedColor.g = ((int)palette[i].g + (int)palette[j].g) / 2;
 			blendedColor.b = ((int)palette[i].b + (int)palette[j].b) / 2;
 			Uint8 best = FindBestMatchForColor(palette, blendedColor, skipFrom, skipTo);
-			paletteTransparencyLookup[i][j] = best;
+			table[i][j] = best;
 		}
 	}
+}
 
+void UpdateTransparencyLookupBlack16()
+{
 #if DEVILUTIONX_PALETTE_TRANSPARENCY_BLACK_16_LUT
 	for (unsigned i = 0; i < 256; ++i) {
 		for (unsigned j = 0; j < 256; ++j) {
@@ -235,42 +236,46 @@ void LoadPalette(const char *pszFileName, bool blend /*= true*/)
 	}
 
 	if (blend) {
-		if (leveltype == DTYPE_CAVES || leveltype == DTYPE_CRYPT) {
-			GenerateBlendedLookupTable(orig_palette, 1, 31);
-		} else if (leveltype == DTYPE_NEST) {
-			GenerateBlendedLookupTable(orig_palette, 1, 15);
-		} else {
-			GenerateBlendedLookupTable(orig_palette, -1, -1);
-		}
+		if (!TakePrefetchedBlendedLookupTable(pszFileName, leveltype, paletteTransparencyLookup))
+			GenerateBlendedLookupTable(orig_palette, leveltype, paletteTransparencyLookup);
+		UpdateTransparencyLookupBlack16();
 	}
 }
 
-void LoadRndLvlPal(dungeon_type l)
+void GenerateBlendedLookupTable(const SDL_Color *palette, dungeon_type type, Uint8 (*table)[256])
 {
-	if (HeadlessMode)
-		return;
-
-	if (l == DTYPE_TOWN) {
-		LoadPalette("levels\\towndata\\town.pal");
-		return;
-	}
-
-	int rv = GenerateRnd(4) + 1;
-	if (l == DTYPE_CRYPT) {
-		LoadPalette("nlevels\\l5data\\l5base.pal");
-		return;
+	if (type == DTYPE_CAVES || type == DTYPE_CRYPT) {
+		GenerateBlendedLookupTable(palette, 1, 31, table);
+	} else if (type == DTYPE_NEST) {
+		GenerateBlendedLookupTable(palette, 1, 15, table);
+	} else {
+		GenerateBlendedLookupTable(palette, -1, -1, table);
 	}
+}
 
-	char szFileName[27];
+std::string GetLevelPalettePath(dungeon_type l, int number)
+{
+	if (l == DTYPE_TOWN)
+		return "levels\\towndata\\town.pal";
+	if (l == DTYPE_CRYPT)
+		return "nlevels\\l5data\\l5base.pal";
 	if (l == DTYPE_NEST) {
 		if (!*sgOptions.Graphics.alternateNestArt) {
-			rv++;
+			number++;
 		}
-		*fmt::format_to(szFileName, R"(nlevels\l{0}data\l{0}base{1}.pal)", 6, rv) = '\0';
-	} else {
-		*fmt::format_to(szFileName, R"(levels\l{0}data\l{0}_{1}.pal)", static_cast<int>(l), rv) = '\0';
+		return fmt::format(R"(nlevels\l{0}data\l{0}base{1}.pal)", 6, number);
 	}
-	LoadPalette(szFileName);
+	return fmt::format(R"(levels\l{0}data\l{0}_{1}.pal)", static_cast<int>(l), number);
+}
+
+void LoadRndLvlPal(dungeon_type l)
+{
+	if (HeadlessMode)
+		return;
+
+	// The town palette is fixed, every other level type rolls for one, even if it only has a single palette.
+	const int number = l == DTYPE_TOWN ? 1 : GenerateRnd(NumLevelPalettes) + 1;
+	LoadPalette(GetLevelPalettePath(l, number).c_str());
 }
 
 void IncreaseGamma()
@@ -6,6 +6,7 @@
 #pragma once
 
 #include <cstdint>
+#include <string>
 
 #include "levels/gendung.h"
 
@@ -50,9 +51,25 @@ extern Uint8 paletteTransparencyLookup[256][256];
 extern uint16_t paletteTransparencyLookupBlack16[65536];
 #endif
 
+/** Number of palettes that `LoadRndLvlPal` picks from. */
+constexpr int NumLevelPalettes = 4;
+
 void palette_update(int first = 0, int ncolor = 256);
 void palette_init();
 void LoadPalette(const char *pszFileName, bool blend = true);
+
+/**
+ * @brief Generates the transparency lookup table that `LoadPalette` sets up for a level of the given type.
+ *
+ * Only writes to `table`, so it may run on any thread.
+ */
+void GenerateBlendedLookupTable(const SDL_Color *palette, dungeon_type type, Uint8 (*table)[256]);
+
+/**
+ * @brief Returns the path of a level palette.
+ * @param number The palette that `LoadRndLvlPal` rolled, in `[1, NumLevelPalettes]`.
+ */
+std::string GetLevelPalettePath(dungeon_type l, int number);
 void LoadRndLvlPal(dungeon_type l);
 void IncreaseGamma();
 void ApplyGamma(SDL_Color *dst, const SDL_Color *src, int n);
@@ -6,8 +6,13 @@
 
 namespace devilution {
 
-/** Current game seed */
-uint32_t sglGameSeed;
+/**
+ * Current game seed
+ *
+ * Each thread has its own, so that tools can generate items or levels on several threads at once. The game itself
+ * only uses the RNG on the main thread.
+ */
+thread_local uint32_t sglGameSeed;
 
 /**
  * Specifies the increment used in the Borland C/C++ pseudo-random number generator algorithm.
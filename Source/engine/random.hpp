@@ -15,6 +15,9 @@ namespace devilution {
 
 /**
  * @brief Set the state of the RandomNumberEngine used by the base game to the specific seed
+ *
+ * The engine state is per thread, a new thread starts with a state of 0.
+ *
  * @param seed New engine state
  */
 void SetRndSeed(uint32_t seed);
@@ -0,0 +1,153 @@
+/**
+ * @file draw_list.cpp
+ *
+ * Implementation of the per-frame list of dungeon draw commands.
+ */
+#include "engine/render/draw_list.hpp"
+
+#include <algorithm>
+
+#include "engine.h"
+#include "engine/render/clx_render.hpp"
+#include "lighting.h"
+
+namespace devilution {
+
+namespace {
+
+bool Intersects(const Rectangle &bounds, const Surface &out)
+{
+	return bounds.position.x < out.w() && bounds.position.x + bounds.size.width > 0
+	    && bounds.position.y < out.h() && bounds.position.y + bounds.size.height > 0;
+}
+
+void Submit(const Surface &out, const DrawCommand &command, Point position)
+{
+	// The lighting variants are spelled out instead of going through `ClxDrawLight`,
+	// which reads the global `LightTableIndex`.
+	switch (command.mode) {
+	case BlitMode::Tile:
+		RenderTile(out, position, LevelCelBlock { command.levelCelBlock }, static_cast<MaskType>(command.param), command.lightTableIndex);
+		break;
+	case BlitMode::Plain:
+		ClxDraw(out, position, *command.sprite);
+		break;
+	case BlitMode::TRN:
+		ClxDrawTRN(out, position, *command.sprite, command.trn);
+		break;
+	case BlitMode::Light:
+		if (command.lightTableIndex != 0)
+			ClxDrawTRN(out, position, *command.sprite, LightTables[command.lightTableIndex].data());
+		else
+			ClxDraw(out, position, *command.sprite);
+		break;
+	case BlitMode::LightBlended:
+		ClxDrawBlendedTRN(out, position, *command.sprite, LightTables[command.lightTableIndex].data());
+		break;
+	case BlitMode::Outline:
+		ClxDrawOutlineSkipColorZero(out, command.param, position, *command.sprite);
+		break;
+	case BlitMode::BlackTile:
+		world_draw_black_tile(out, position.x, position.y);
+		break;
+	}
+}
+
+} // namespace
+
+Rectangle DrawCommand::bounds() const
+{
+	if (mode == BlitMode::Tile) {
+		// Triangles are one pixel shorter than squares, see `GetTileHeight`.
+		return { { position.x, position.y - TILE_HEIGHT + 1 }, { TILE_WIDTH / 2, TILE_HEIGHT } };
+	}
+	if (mode == BlitMode::BlackTile)
+		return { { position.x, position.y - TILE_HEIGHT + 1 }, { TILE_WIDTH, TILE_HEIGHT } };
+	const int width = sprite->width();
+	const int height = sprite->height();
+	if (mode == BlitMode::Outline) {
+		// Outlines extend one pixel beyond the sprite in every direction.
+		return { { position.x - 1, position.y - height }, { width + 2, height + 2 } };
+	}
+	return { { position.x, position.y - height + 1 }, { width, height } };
+}
+
+void DrawList::clear()
+{
+	commands_.clear();
+	tileOrder_ = 0;
+}
+
+void DrawList::addTile(Point position, LevelCelBlock levelCelBlock, MaskType maskType, uint8_t lightTableIndex)
+{
+	DrawCommand &command = commands_.emplace_back();
+	command.depth = depth(DrawLayer::Cell);
+	command.position = position;
+	command.mode = BlitMode::Tile;
+	command.lightTableIndex = lightTableIndex;
+	command.param = static_cast<uint8_t>(maskType);
+	command.levelCelBlock = static_cast<uint16_t>((static_cast<uint16_t>(levelCelBlock.type()) << 12) | levelCelBlock.frame());
+	command.sprite = std::nullopt;
+	command.trn = nullptr;
+}
+
+void DrawList::addBlackTile(Point position)
+{
+	DrawCommand &command = commands_.emplace_back();
+	command.depth = depth(DrawLayer::Cell);
+	command.position = position;
+	command.mode = BlitMode::BlackTile;
+	command.lightTableIndex = 0;
+	command.param = 0;
+	command.levelCelBlock = 0;
+	command.sprite = std::nullopt;
+	command.trn = nullptr;
+}
+
+void DrawList::addSprite(DrawLayer layer, BlitMode mode, Point position, ClxSprite sprite, const uint8_t *trn)
+{
+	DrawCommand &command = commands_.emplace_back();
+	command.depth = depth(layer);
+	command.position = position;
+	command.mode = mode;
+	command.lightTableIndex = static_cast<uint8_t>(LightTableIndex);
+	command.param = 0;
+	command.levelCelBlock = 0;
+	command.sprite.emplace(sprite);
+	command.trn = trn;
+}
+
+void DrawList::addOutline(DrawLayer layer, uint8_t color, Point position, ClxSprite sprite)
+{
+	DrawCommand &command = commands_.emplace_back();
+	command.depth = depth(layer);
+	command.position = position;
+	command.mode = BlitMode::Outline;
+	command.lightTableIndex = static_cast<uint8_t>(LightTableIndex);
+	command.param = color;
+	command.levelCelBlock = 0;
+	command.sprite.emplace(sprite);
+	command.trn = nullptr;
+}
+
+void DrawList::sort()
+{
+	const auto byDepth = [](const DrawCommand &a, const DrawCommand &b) { return a.depth < b.depth; };
+	// Commands are usually recorded in order already.
+	if (std::is_sorted(commands_.begin(), commands_.end(), byDepth))
+		return;
+	std::stable_sort(commands_.begin(), commands_.end(), byDepth);
+}
+
+void DrawList::submit(const Surface &out, Displacement offset) const
+{
+	for (const DrawCommand &command : commands_) {
+		Rectangle bounds = command.bounds();
+		bounds.position += offset;
+		if (!Intersects(bounds, out))
+			continue;
+		Submit(out, command, command.position + offset);
+	}
+}
+
+} // namespace devilution
@@ -0,0 +1,148 @@
+/**
+ * @file draw_list.hpp
+ *
+ * Interface of the per-frame list of dungeon draw commands.
+ */
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "engine/clx_sprite.hpp"
+#include "engine/point.hpp"
+#include "engine/rectangle.hpp"
+#include "engine/render/dun_render.hpp"
+#include "engine/surface.hpp"
+
+namespace devilution {
+
+/**
+ * @brief The layers drawn for every dungeon tile, from back to front.
+ *
+ * The order matches the order in which `DrawDungeon` used to blit the
+ * contents of a tile directly to the back buffer.
+ */
+enum class DrawLayer : uint8_t {
+	Cell,
+	Debug,
+	MissilePre,
+	Corpse,
+	ObjectPre,
+	ItemPre,
+	DeadPlayer,
+	Player,
+	Monster,
+	Missile,
+	Object,
+	Item,
+	Special,
+};
+
+/**
+ * @brief How a draw command is rasterized.
+ */
+enum class BlitMode : uint8_t {
+	/** @brief A level CEL block, see `RenderTile`. */
+	Tile,
+	/** @brief `ClxDraw` */
+	Plain,
+	/** @brief `ClxDrawTRN` */
+	TRN,
+	/** @brief `ClxDrawLight` */
+	Light,
+	/** @brief `ClxDrawLightBlended` */
+	LightBlended,
+	/** @brief `ClxDrawOutlineSkipColorZero` */
+	Outline,
+	/** @brief `world_draw_black_tile`, for tiles outside of the dungeon. */
+	BlackTile,
+};
+
+struct DrawCommand {
+	/** @brief Sort key, commands with a lower depth are drawn first. */
+	uint32_t depth;
+	/** @brief Target buffer coordinates of the bottom-left corner. */
+	Point position;
+	BlitMode mode;
+	/** @brief Value of `LightTableIndex` when the command was recorded. */
+	uint8_t lightTableIndex;
+	/** @brief Outline color for `BlitMode::Outline`, `MaskType` for `BlitMode::Tile`. */
+	uint8_t param;
+	/** @brief Raw `LevelCelBlock` value for `BlitMode::Tile`. */
+	uint16_t levelCelBlock;
+	OptionalClxSprite sprite;
+	const uint8_t *trn;
+
+	/**
+	 * @brief The target buffer area that this command may touch.
+	 */
+	[[nodiscard]] Rectangle bounds() const;
+};
+
+/**
+ * @brief Collects the sprites and tiles of the dungeon view so that they can be
+ * sorted back to front and submitted to the back buffer in one pass.
+ *
+ * Commands are recorded per tile: call `nextTile` before recording the
+ * contents of a new tile, the tile order together with the `DrawLayer`
+ * forms the depth key. Commands recorded before the first `nextTile`, such
+ * as the floor, are drawn before all tiles.
+ *
+ * Once recorded, the list only refers to graphics and light tables, not to
+ * the game state, so it can be rasterized while the game moves on.
+ */
+class DrawList {
+public:
+	void clear();
+
+	/**
+	 * @brief Starts recording the contents of the next tile.
+	 */
+	void nextTile()
+	{
+		++tileOrder_;
+	}
+
+	void addTile(Point position, LevelCelBlock levelCelBlock, MaskType maskType, uint8_t lightTableIndex);
+
+	void addBlackTile(Point position);
+
+	/**
+	 * @brief Records a sprite, `BlitMode::Light` and `BlitMode::LightBlended` capture the current `LightTableIndex`.
+	 */
+	void addSprite(DrawLayer layer, BlitMode mode, Point position, ClxSprite sprite, const uint8_t *trn = nullptr);
+
+	void addOutline(DrawLayer layer, uint8_t color, Point position, ClxSprite sprite);
+
+	/**
+	 * @brief Orders the commands back to front, commands with the same depth keep their recording order.
+	 */
+	void sort();
+
+	/**
+	 * @brief Blits all commands that intersect the given buffer, in order.
+	 *
+	 * Does not modify any global state, so disjoint regions of the same
+	 * buffer can be submitted from different threads.
+	 *
+	 * @param out Target buffer
+	 * @param offset Added to the position of every command, used to render into a subregion
+	 */
+	void submit(const Surface &out, Displacement offset = {}) const;
+
+	[[nodiscard]] const std::vector<DrawCommand> &commands() const
+	{
+		return commands_;
+	}
+
+private:
+	[[nodiscard]] uint32_t depth(DrawLayer layer) const
+	{
+		return (tileOrder_ << 4) | static_cast<uint8_t>(layer);
+	}
+
+	std::vector<DrawCommand> commands_;
+	uint32_t tileOrder_ = 0;
+};
+
+} // namespace devilution
@@ -17,11 +17,16 @@
 #include <algorithm>
 #include <climits>
 #include <cstdint>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
 
 #include "engine/render/blit_impl.hpp"
 #include "lighting.h"
 #include "options.h"
 #include "utils/attributes.h"
+#include "utils/sdl_mutex.h"
 #include "utils/stdcompat/algorithm.hpp"
 #ifdef DEBUG_STR
 #include "engine/render/text_render.hpp"
@@ -30,6 +35,11 @@
 #include "utils/str_cat.hpp"
 #endif
 
+#ifndef TILE_LIGHT_CACHE_MAX_BYTES
+// Off by default until a timedemo shows that it is faster than applying the light table while rendering.
+#define TILE_LIGHT_CACHE_MAX_BYTES 0
+#endif
+
 namespace devilution {
 
 namespace {
@@ -1088,10 +1098,178 @@ void RenderBlackTileFull(uint8_t *DVL_RESTRICT dst, uint16_t dstPitch)
 	}
 }
 
+#if !defined(DEBUG_RENDER_COLOR) && TILE_LIGHT_CACHE_MAX_BYTES > 0
+/**
+ * @brief LRU cache of level CEL frames with a light table already applied.
+ *
+ * A pre-lit frame has the same layout as the original, so it can be rendered
+ * with `LightType::FullyLit`, which copies the pixels instead of looking each
+ * one up in the light table. The mask is applied when rendering, so it is not
+ * part of the key.
+ *
+ * Rendering threads share the cache. Only the lookup holds the lock, a miss
+ * reserves its slot and applies the light table after releasing it. Slots used
+ * in the current frame are never evicted, so the returned pointers stay valid
+ * until `BeginTileLightCacheFrame`.
+ */
+class TileLightCache {
+public:
+	/** Frames larger than a slot (transparent squares with many runs) are not cached. */
+	static constexpr size_t SlotSize = Width * Height;
+
+	const uint8_t *get(LevelCelBlock levelCelBlock, uint8_t lightTableIndex, const uint8_t *src, size_t size)
+	{
+		if (size > SlotSize)
+			return nullptr;
+
+		std::unique_lock<SdlMutex> lock(mutex_);
+		const TileType tile = levelCelBlock.type();
+		const uint32_t key = (((static_cast<uint32_t>(tile) << 12) | levelCelBlock.frame()) << 4) | lightTableIndex;
+		const auto it = slotByKey_.find(key);
+		if (it != slotByKey_.end()) {
+			const uint32_t slot = it->second;
+			if (!slots_[slot].lit)
+				return nullptr; // Another thread is still lighting the frame.
+			touch(slot);
+#ifdef DUN_RENDER_STATS
+			++TileLightCacheHits;
+#endif
+			return &atlas_[slot * SlotSize];
+		}
+#ifdef DUN_RENDER_STATS
+		++TileLightCacheMisses;
+#endif
+
+		uint32_t slot;
+		if (slots_.size() < MaxSlots) {
+			if (atlas_ == nullptr)
+				atlas_ = std::make_unique<uint8_t[]>(MaxSlots * SlotSize);
+			slot = static_cast<uint32_t>(slots_.size());
+			slots_.emplace_back();
+			link(slot);
+		} else {
+			slot = tail_;
+			if (slots_[slot].frame == frame_)
+				return nullptr; // Every slot is in use by the current frame.
+			slotByKey_.erase(slots_[slot].key);
+			touch(slot);
+		}
+		slots_[slot].key = key;
+		slots_[slot].frame = frame_;
+		slots_[slot].lit = false;
+		slotByKey_.emplace(key, slot);
+		lock.unlock();
+
+		uint8_t *dst = &atlas_[slot * SlotSize];
+		Light(dst, src, size, tile, LightTables[lightTableIndex].data());
+
+		lock.lock();
+		slots_[slot].lit = true;
+		return dst;
+	}
+
+	void clear()
+	{
+		const std::lock_guard<SdlMutex> lock(mutex_);
+		slots_.clear();
+		slotByKey_.clear();
+		head_ = NoSlot;
+		tail_ = NoSlot;
+	}
+
+	void beginFrame()
+	{
+		const std::lock_guard<SdlMutex> lock(mutex_);
+		++frame_;
+	}
+
+private:
+	static constexpr size_t MaxSlots = std::max<size_t>(TILE_LIGHT_CACHE_MAX_BYTES / SlotSize, 1);
+	static constexpr uint32_t NoSlot = static_cast<uint32_t>(-1);
+
+	struct Slot {
+		uint32_t key;
+		uint32_t frame;
+		uint32_t prev;
+		uint32_t next;
+		/** Whether the light table is applied, until then the slot is reserved by the thread applying it. */
+		bool lit;
+	};
+
+	static void Light(uint8_t *DVL_RESTRICT dst, const uint8_t *DVL_RESTRICT src, size_t size, TileType tile, const uint8_t *DVL_RESTRICT tbl)
+	{
+		if (tile != TileType::TransparentSquare) {
+			// Only pixels and padding that is never read.
+			for (size_t i = 0; i < size; ++i)
+				dst[i] = tbl[src[i]];
+			return;
+		}
+		// Transparent squares are run-length encoded, the run headers are kept as is.
+		const uint8_t *end = src + size;
+		while (src < end) {
+			const auto v = static_cast<int8_t>(*src);
+			*dst++ = *src++;
+			if (v <= 0)
+				continue;
+			const size_t width = std::min<size_t>(v, end - src);
+			for (size_t i = 0; i < width; ++i)
+				dst[i] = tbl[src[i]];
+			dst += width;
+			src += width;
+		}
+	}
+
+	void link(uint32_t slot)
+	{
+		slots_[slot].prev = NoSlot;
+		slots_[slot].next = head_;
+		if (head_ != NoSlot)
+			slots_[head_].prev = slot;
+		head_ = slot;
+		if (tail_ == NoSlot)
+			tail_ = slot;
+	}
+
+	void unlink(uint32_t slot)
+	{
+		const Slot &entry = slots_[slot];
+		if (entry.prev != NoSlot)
+			slots_[entry.prev].next = entry.next;
+		else
+			head_ = entry.next;
+		if (entry.next != NoSlot)
+			slots_[entry.next].prev = entry.prev;
+		else
+			tail_ = entry.prev;
+	}
+
+	void touch(uint32_t slot)
+	{
+		slots_[slot].frame = frame_;
+		if (head_ == slot)
+			return;
+		unlink(slot);
+		link(slot);
+	}
+
+	SdlMutex mutex_;
+	std::unique_ptr<uint8_t[]> atlas_;
+	std::vector<Slot> slots_;
+	std::unordered_map<uint32_t, uint32_t> slotByKey_;
+	uint32_t head_ = NoSlot;
+	uint32_t tail_ = NoSlot;
+	uint32_t frame_ = 0;
+};
+
+TileLightCache LitTiles;
+#endif
+
 } // namespace
 
 #ifdef DUN_RENDER_STATS
 std::unordered_map<DunRenderType, size_t, DunRenderTypeHash> DunRenderStats;
+size_t TileLightCacheHits;
+size_t TileLightCacheMisses;
 
 string_view TileTypeToString(TileType tileType)
 {
@@ -1143,9 +1321,19 @@ void RenderTile(const Surface &out, Point position,
 	if (clip.width <= 0 || clip.height <= 0)
 		return;
 
-	const uint8_t *tbl = LightTables[LightTableIndex].data();
+	const uint8_t *tbl = LightTables[lightTableIndex].data();
 	const auto *pFrameTable = reinterpret_cast<const uint32_t *>(pDungeonCels.get());
 	const auto *src = reinterpret_cast<const uint8_t *>(&pDungeonCels[SDL_SwapLE32(pFrameTable[levelCelBlock.frame()])]);
+#if !defined(DEBUG_RENDER_COLOR) && TILE_LIGHT_CACHE_MAX_BYTES > 0
+	if (lightTableIndex != 0 && lightTableIndex != LightsMax) {
+		const size_t size = SDL_SwapLE32(pFrameTable[levelCelBlock.frame() + 1]) - SDL_SwapLE32(pFrameTable[levelCelBlock.frame()]);
+		const uint8_t *litSrc = LitTiles.get(levelCelBlock, lightTableIndex, src, size);
+		if (litSrc != nullptr) {
+			src = litSrc;
+			lightTableIndex = 0;
+		}
+	}
+#endif
 	uint8_t *dst = out.at(static_cast<int>(position.x + clip.left), static_cast<int>(position.y - clip.bottom));
 	const uint16_t dstPitch = out.pitch();
 
@@ -1180,6 +1368,20 @@ void RenderTile(const Surface &out, Point position,
 #endif
 }
 
+void ClearTileLightCache()
+{
+#if !defined(DEBUG_RENDER_COLOR) && TILE_LIGHT_CACHE_MAX_BYTES > 0
+	LitTiles.clear();
+#endif
+}
+
+void BeginTileLightCacheFrame()
+{
+#if !defined(DEBUG_RENDER_COLOR) && TILE_LIGHT_CACHE_MAX_BYTES > 0
+	LitTiles.beginFrame();
+#endif
+}
+
 void world_draw_black_tile(const Surface &out, int sx, int sy)
 {
 #ifdef DEBUG_RENDER_OFFSET_X
@@ -1,123 +1,171 @@
 /**
- * @file clx_render.hpp
+ * @file dun_render.hpp
  *
- * CL2 rendering.
+ * Interface of functionality for rendering the level tiles.
  */
 #pragma once
 
 #include <cstdint>
 
-#include <array>
-#include <utility>
-
-#ifdef DEBUG_CLX
-#include <string>
+#ifdef DUN_RENDER_STATS
+#include <cstddef>
+#include <functional>
+#include <unordered_map>
 #endif
 
 #include "engine.h"
-#include "engine/clx_sprite.hpp"
 #include "engine/point.hpp"
-#include "lighting.h"
+#include "engine/surface.hpp"
+#ifdef DUN_RENDER_STATS
+#include "utils/stdcompat/string_view.hpp"
+#endif
+
+// #define DUN_RENDER_STATS
 
 namespace devilution {
 
 /**
- * @brief Apply the color swaps to a CLX sprite list;
+ * @brief Dungeon tile type.
+ *
+ * Determines the shape and the encoding of a level CEL frame.
  */
-void ClxApplyTrans(ClxSpriteList list, const uint8_t *trn);
-void ClxApplyTrans(ClxSpriteSheet sheet, const uint8_t *trn);
+enum class TileType : uint8_t {
+	Square,
+	TransparentSquare,
+	LeftTriangle,
+	RightTriangle,
+	LeftTrapezoid,
+	RightTrapezoid,
+};
 
 /**
- * @brief Blit CL2 sprite, to the back buffer at the given coordianates
- * @param out Output buffer
- * @param position Target buffer coordinate
- * @param clx CLX frame
- * @param frame CL2 frame number
+ * @brief Specifies the mask to use for rendering.
  */
-void ClxDraw(const Surface &out, Point position, ClxSprite clx);
+enum class MaskType : uint8_t {
+	/** @brief The entire tile is opaque. */
+	Solid,
+
+	/** @brief The entire tile is blended with transparency. */
+	Transparent,
+
+	/**
+	 * @brief Upper-right triangle is blended with transparency.
+	 *
+	 * Can only be used with `TileType::LeftTrapezoid` and
+	 * `TileType::TransparentSquare`.
+	 */
+	Right,
+
+	/**
+	 * @brief Upper-left triangle is blended with transparency.
+	 *
+	 * Can only be used with `TileType::RightTrapezoid` and
+	 * `TileType::TransparentSquare`.
+	 */
+	Left,
+
+	/**
+	 * @brief Only the upper-left triangle is rendered.
+	 *
+	 * Can only be used with `TileType::TransparentSquare`.
+	 */
+	RightFoliage,
+
+	/**
+	 * @brief Only the upper right triangle is rendered.
+	 *
+	 * Can only be used with `TileType::TransparentSquare`.
+	 */
+	LeftFoliage,
+};
 
 /**
- * @brief Same as ClxDraw but position.y is the top of the sprite instead of the bottom.
+ * @brief A single level CEL block reference as stored in `MICROS`.
  */
-inline void RenderClxSprite(const Surface &out, ClxSprite clx, Point position)
-{
-	ClxDraw(out, { position.x, position.y + static_cast<int>(clx.height()) - 1 }, clx);
-}
+class LevelCelBlock {
+public:
+	explicit LevelCelBlock(uint16_t data)
+	    : data_(data)
+	{
+	}
+
+	[[nodiscard]] bool hasValue() const
+	{
+		return data_ != 0;
+	}
+
+	[[nodiscard]] TileType type() const
+	{
+		return static_cast<TileType>((data_ & 0x7000) >> 12);
+	}
+
+	/**
+	 * @brief The CEL frame index into `pDungeonCels`.
+	 */
+	[[nodiscard]] uint16_t frame() const
+	{
+		return data_ & 0xFFF;
+	}
+
+private:
+	uint16_t data_;
+};
+
+#ifdef DUN_RENDER_STATS
+struct DunRenderType {
+	TileType tileType;
+	MaskType maskType;
+	bool operator==(const DunRenderType &other) const
+	{
+		return tileType == other.tileType && maskType == other.maskType;
+	}
+};
+struct DunRenderTypeHash {
+	size_t operator()(DunRenderType t) const noexcept
+	{
+		return std::hash<uint32_t> {}((1 < static_cast<uint8_t>(t.tileType)) | static_cast<uint8_t>(t.maskType));
+	}
+};
+extern std::unordered_map<DunRenderType, size_t, DunRenderTypeHash> DunRenderStats;
+extern size_t TileLightCacheHits;
+extern size_t TileLightCacheMisses;
+
+string_view TileTypeToString(TileType tileType);
+
+string_view MaskTypeToString(MaskType maskType);
+#endif
 
 /**
- * @brief Blit a solid colder shape one pixel larger than the given sprite shape, to the given buffer at the given coordinates
- * @param col Color index from current palette
- * @param out Output buffer
- * @param position Target buffer coordinate
- * @param clx CLX frame
+ * @brief Blit current world CEL to the given buffer
+ * @param out Target buffer
+ * @param position Target buffer coordinates
+ * @param levelCelBlock The MIN block of the level CEL file.
+ * @param maskType The mask to use,
+ * @param lightTableIndex The light level to use for rendering (index into LightTables / 256).
  */
-void ClxDrawOutline(const Surface &out, uint8_t col, Point position, ClxSprite clx);
+void RenderTile(const Surface &out, Point position,
+    LevelCelBlock levelCelBlock, MaskType maskType, uint8_t lightTableIndex);
 
 /**
- * @brief Same as `ClxDrawOutline` but considers colors with index 0 (usually shadows) to be transparent.
+ * @brief Drops all pre-lit level CEL frames.
  *
- * @param col Color index from current palette
- * @param out Output buffer
- * @param position Target buffer coordinate
- * @param clx CLX frame
+ * Must be called whenever the level CEL file or the light tables change.
  */
-void ClxDrawOutlineSkipColorZero(const Surface &out, uint8_t col, Point position, ClxSprite clx);
+void ClearTileLightCache();
 
 /**
- * @brief Blit CL2 sprite, and apply given TRN to the given buffer at the given coordinates
- * @param out Output buffer
- * @param position Target buffer coordinate
- * @param clx CLX frame
- * @param trn TRN to use
- */
-void ClxDrawTRN(const Surface &out, Point position, ClxSprite clx, const uint8_t *trn);
-
-/**
- * @brief Same as ClxDrawTRN but position.y is the top of the sprite instead of the bottom.
- */
-inline void RenderClxSpriteWithTRN(const Surface &out, ClxSprite clx, Point position, const uint8_t *trn)
-{
-	ClxDrawTRN(out, { position.x, position.y + static_cast<int>(clx.height()) - 1 }, clx, trn);
-}
-
-void ClxDrawBlendedTRN(const Surface &out, Point position, ClxSprite clx, const uint8_t *trn);
-
-// defined in scrollrt.cpp
-extern int LightTableIndex;
-
-/**
- * @brief Blit CL2 sprite, and apply lighting, to the given buffer at the given coordinates
- * @param out Output buffer
- * @param position Target buffer coordinate
- * @param clx CLX frame
- */
-inline void ClxDrawLight(const Surface &out, Point position, ClxSprite clx)
-{
-	if (LightTableIndex != 0)
-		ClxDrawTRN(out, position, clx, LightTables[LightTableIndex].data());
-	else
-		ClxDraw(out, position, clx);
-}
-
-/**
- * @brief Blit CL2 sprite, and apply lighting and transparency blending, to the given buffer at the given coordinates
- * @param out Output buffer
- * @param position Target buffer coordinate
- * @param clx CLX frame
+ * @brief Starts a new frame for the pre-lit level CEL frame cache.
+ *
+ * Frames used since the last call are not evicted, so tiles can be rendered from multiple threads.
  */
-inline void ClxDrawLightBlended(const Surface &out, Point position, ClxSprite clx)
-{
-	ClxDrawBlendedTRN(out, position, clx, LightTables[LightTableIndex].data());
-}
+void BeginTileLightCacheFrame();
 
 /**
- * Returns a pair of X coordinates containing the start (inclusive) and end (exclusive)
- * of fully transparent columns in the sprite.
+ * @brief Render a black 64x31 tile ◆
+ * @param out Target buffer
+ * @param sx Target buffer coordinate (left corner of the tile)
+ * @param sy Target buffer coordinate (bottom corner of the tile)
  */
-std::pair<int, int> ClxMeasureSolidHorizontalBounds(ClxSprite clx);
-
-#ifdef DEBUG_CLX
-std::string ClxDescribe(ClxSprite clx);
-#endif
+void world_draw_black_tile(const Surface &out, int sx, int sy);
 
 } // namespace devilution
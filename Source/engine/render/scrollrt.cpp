@@ -7,6 +7,8 @@
 
 #include "DiabloUI/ui_flags.hpp"
 #include "automap.h"
+#include "capture.h"
+#include "controls/input.h"
 #include "controls/plrctrls.h"
 #include "cursor.h"
 #include "dead.h"
@@ -14,6 +16,7 @@
 #include "engine/backbuffer_state.hpp"
 #include "engine/dx.h"
 #include "engine/render/clx_render.hpp"
+#include "engine/render/draw_list.hpp"
 #include "engine/render/dun_render.hpp"
 #include "engine/render/text_render.hpp"
 #include "engine/trn.hpp"
@@ -42,7 +45,11 @@
 #include "utils/display.h"
 #include "utils/endian.hpp"
 #include "utils/log.hpp"
+#include "utils/sdl_cond.h"
+#include "utils/sdl_mutex.h"
+#include "utils/sdl_thread.h"
 #include "utils/str_cat.hpp"
+#include "utils/worker_pool.hpp"
 
 #ifndef USE_SDL1
 #include "controls/touch/renderers.h"
@@ -87,6 +94,16 @@ struct PointHash {
  */
 std::unordered_multimap<Point, Missile *, PointHash> MissilesAtRenderingTile;
 
+/**
+ * @brief Sprites and tiles of the dungeon view, recorded by `DrawTileContent` and submitted back to front.
+ */
+DrawList FrameDrawList;
+
+/**
+ * @brief Threads that help rendering the game view, see `GraphicsOptions::renderThreads`.
+ */
+std::unique_ptr<WorkerPool> RenderWorkers;
+
 /**
  * @brief Could the missile (at the next game tick) collide? This method is a simplified version of CheckMissileCol (for example without random).
  */
@@ -279,50 +296,51 @@ void DrawCursor(const Surface &out)
 }
 
 /**
- * @brief Render a missile sprite
- * @param out Output buffer
+ * @brief Record a missile sprite
+ * @param drawList Draw list of the frame
  * @param missile Pointer to Missile struct
  * @param targetBufferPosition Output buffer coordinate
  * @param pre Is the sprite in the background
  */
-void DrawMissilePrivate(const Surface &out, const Missile &missile, Point targetBufferPosition, bool pre)
+void DrawMissilePrivate(DrawList &drawList, const Missile &missile, Point targetBufferPosition, bool pre)
 {
 	if (missile._miPreFlag != pre || !missile._miDrawFlag)
 		return;
 
 	const Point missileRenderPosition { targetBufferPosition + missile.position.offsetForRendering - Displacement { missile._miAnimWidth2, 0 } };
 	const ClxSprite sprite = (*missile._miAnimData)[missile._miAnimFrame - 1];
+	const DrawLayer layer = pre ? DrawLayer::MissilePre : DrawLayer::Missile;
 	if (missile._miUniqTrans != 0)
-		ClxDrawTRN(out, missileRenderPosition, sprite, Monsters[missile._misource].uniqueMonsterTRN.get());
+		drawList.addSprite(layer, BlitMode::TRN, missileRenderPosition, sprite, Monsters[missile._misource].uniqueMonsterTRN.get());
 	else if (missile._miLightFlag)
-		ClxDrawLight(out, missileRenderPosition, sprite);
+		drawList.addSprite(layer, BlitMode::Light, missileRenderPosition, sprite);
 	else
-		ClxDraw(out, missileRenderPosition, sprite);
+		drawList.addSprite(layer, BlitMode::Plain, missileRenderPosition, sprite);
 }
 
 /**
- * @brief Render a missile sprites for a given tile
- * @param out Output buffer
+ * @brief Record the missile sprites for a given tile
+ * @param drawList Draw list of the frame
  * @param tilePosition dPiece coordinates
  * @param targetBufferPosition Output buffer coordinates
  * @param pre Is the sprite in the background
  */
-void DrawMissile(const Surface &out, Point tilePosition, Point targetBufferPosition, bool pre)
+void DrawMissile(DrawList &drawList, Point tilePosition, Point targetBufferPosition, bool pre)
 {
 	const auto range = MissilesAtRenderingTile.equal_range(tilePosition);
 	for (auto it = range.first; it != range.second; it++) {
-		DrawMissilePrivate(out, *it->second, targetBufferPosition, pre);
+		DrawMissilePrivate(drawList, *it->second, targetBufferPosition, pre);
 	}
 }
 
 /**
- * @brief Render a monster sprite
- * @param out Output buffer
+ * @brief Record a monster sprite
+ * @param drawList Draw list of the frame
  * @param tilePosition dPiece coordinates
  * @param targetBufferPosition Output buffer coordinates
  * @param monster Monster reference
  */
-void DrawMonster(const Surface &out, Point tilePosition, Point targetBufferPosition, const Monster &monster)
+void DrawMonster(DrawList &drawList, Point tilePosition, Point targetBufferPosition, const Monster &monster)
 {
 	if (!monster.animInfo.sprites) {
 		Log("Draw Monster \"{}\": NULL Cel Buffer", monster.name());
@@ -332,7 +350,7 @@ void DrawMonster(const Surface &out, Point tilePosition, Point targetBufferPosit
 	const ClxSprite sprite = monster.animInfo.currentSprite();
 
 	if (!IsTileLit(tilePosition)) {
-		ClxDrawTRN(out, targetBufferPosition, sprite, GetInfravisionTRN());
+		drawList.addSprite(DrawLayer::Monster, BlitMode::TRN, targetBufferPosition, sprite, GetInfravisionTRN());
 		return;
 	}
 	uint8_t *trn = nullptr;
@@ -343,56 +361,58 @@ void DrawMonster(const Surface &out, Point tilePosition, Point targetBufferPosit
 	if (MyPlayer->_pInfraFlag && LightTableIndex > 8)
 		trn = GetInfravisionTRN();
 	if (trn != nullptr)
-		ClxDrawTRN(out, targetBufferPosition, sprite, trn);
+		drawList.addSprite(DrawLayer::Monster, BlitMode::TRN, targetBufferPosition, sprite, trn);
 	else
-		ClxDrawLight(out, targetBufferPosition, sprite);
+		drawList.addSprite(DrawLayer::Monster, BlitMode::Light, targetBufferPosition, sprite);
 }
 
 /**
  * @brief Helper for rendering a specific player icon (Mana Shield or Reflect)
  */
-void DrawPlayerIconHelper(const Surface &out, MissileGraphicID missileGraphicId, Point position, bool lighting, bool infraVision)
+void DrawPlayerIconHelper(DrawList &drawList, DrawLayer layer, MissileGraphicID missileGraphicId, Point position, bool lighting, bool infraVision)
 {
 	position.x -= GetMissileSpriteData(missileGraphicId).animWidth2;
 
 	const ClxSprite sprite = (*GetMissileSpriteData(missileGraphicId).sprites).list()[0];
 
 	if (!lighting) {
-		ClxDraw(out, position, sprite);
+		drawList.addSprite(layer, BlitMode::Plain, position, sprite);
 		return;
 	}
 
 	if (infraVision) {
-		ClxDrawTRN(out, position, sprite, GetInfravisionTRN());
+		drawList.addSprite(layer, BlitMode::TRN, position, sprite, GetInfravisionTRN());
 		return;
 	}
 
-	ClxDrawLight(out, position, sprite);
+	drawList.addSprite(layer, BlitMode::Light, position, sprite);
 }
 
 /**
  * @brief Helper for rendering player icons (Mana Shield and Reflect)
- * @param out Output buffer
+ * @param drawList Draw list of the frame
+ * @param layer Layer of the player sprite
  * @param player Player reference
  * @param position Output buffer coordinates
  * @param infraVision Should infravision be applied
  */
-void DrawPlayerIcons(const Surface &out, const Player &player, Point position, bool infraVision)
+void DrawPlayerIcons(DrawList &drawList, DrawLayer layer, const Player &player, Point position, bool infraVision)
 {
 	if (player.pManaShield)
-		DrawPlayerIconHelper(out, MissileGraphicID::ManaShield, position, &player != MyPlayer, infraVision);
+		DrawPlayerIconHelper(drawList, layer, MissileGraphicID::ManaShield, position, &player != MyPlayer, infraVision);
 	if (player.wReflections > 0)
-		DrawPlayerIconHelper(out, MissileGraphicID::Reflect, position + Displacement { 0, 16 }, &player != MyPlayer, infraVision);
+		DrawPlayerIconHelper(drawList, layer, MissileGraphicID::Reflect, position + Displacement { 0, 16 }, &player != MyPlayer, infraVision);
 }
 
 /**
- * @brief Render a player sprite
- * @param out Output buffer
+ * @brief Record a player sprite
+ * @param drawList Draw list of the frame
+ * @param layer Layer to record the sprite in
  * @param player Player reference
  * @param tilePosition dPiece coordinates
  * @param targetBufferPosition Output buffer coordinates
  */
-void DrawPlayer(const Surface &out, const Player &player, Point tilePosition, Point targetBufferPosition)
+void DrawPlayer(DrawList &drawList, DrawLayer layer, const Player &player, Point tilePosition, Point targetBufferPosition)
 {
 	if (!IsTileLit(tilePosition) && !MyPlayer->_pInfraFlag && !MyPlayer->isOnArenaLevel() && leveltype != DTYPE_TOWN) {
 		return;
@@ -403,17 +423,17 @@ void DrawPlayer(const Surface &out, const Player &player, Point tilePosition, Po
 	Point spriteBufferPosition = targetBufferPosition - Displacement { CalculateWidth2(sprite.width()), 0 };
 
 	if (static_cast<size_t>(pcursplr) < Players.size() && &player == &Players[pcursplr])
-		ClxDrawOutlineSkipColorZero(out, 165, spriteBufferPosition, sprite);
+		drawList.addOutline(layer, 165, spriteBufferPosition, sprite);
 
 	if (&player == MyPlayer) {
-		ClxDraw(out, spriteBufferPosition, sprite);
-		DrawPlayerIcons(out, player, targetBufferPosition, false);
+		drawList.addSprite(layer, BlitMode::Plain, spriteBufferPosition, sprite);
+		DrawPlayerIcons(drawList, layer, player, targetBufferPosition, false);
 		return;
 	}
 
 	if (!IsTileLit(tilePosition) || ((MyPlayer->_pInfraFlag || MyPlayer->isOnArenaLevel()) && LightTableIndex > 8)) {
-		ClxDrawTRN(out, spriteBufferPosition, sprite, GetInfravisionTRN());
-		DrawPlayerIcons(out, player, targetBufferPosition, true);
+		drawList.addSprite(layer, BlitMode::TRN, spriteBufferPosition, sprite, GetInfravisionTRN());
+		DrawPlayerIcons(drawList, layer, player, targetBufferPosition, true);
 		return;
 	}
 
@@ -423,19 +443,19 @@ void DrawPlayer(const Surface &out, const Player &player, Point tilePosition, Po
 	else
 		LightTableIndex -= 5;
 
-	ClxDrawLight(out, spriteBufferPosition, sprite);
-	DrawPlayerIcons(out, player, targetBufferPosition, false);
+	drawList.addSprite(layer, BlitMode::Light, spriteBufferPosition, sprite);
+	DrawPlayerIcons(drawList, layer, player, targetBufferPosition, false);
 
 	LightTableIndex = l;
 }
 
 /**
- * @brief Render a player sprite
- * @param out Output buffer
+ * @brief Record the sprites of the dead players on a tile
+ * @param drawList Draw list of the frame
  * @param tilePosition dPiece coordinates
  * @param targetBufferPosition Output buffer coordinates
  */
-void DrawDeadPlayer(const Surface &out, Point tilePosition, Point targetBufferPosition)
+void DrawDeadPlayer(DrawList &drawList, Point tilePosition, Point targetBufferPosition)
 {
 	dFlags[tilePosition.x][tilePosition.y] &= ~DungeonFlag::DeadPlayer;
 
@@ -443,19 +463,19 @@ void DrawDeadPlayer(const Surface &out, Point tilePosition, Point targetBufferPo
 		if (player.plractive && player._pHitPoints == 0 && player.isOnActiveLevel() && player.position.tile == tilePosition) {
 			dFlags[tilePosition.x][tilePosition.y] |= DungeonFlag::DeadPlayer;
 			const Point playerRenderPosition { targetBufferPosition };
-			DrawPlayer(out, player, tilePosition, playerRenderPosition);
+			DrawPlayer(drawList, DrawLayer::DeadPlayer, player, tilePosition, playerRenderPosition);
 		}
 	}
 }
 
 /**
- * @brief Render an object sprite
- * @param out Output buffer
+ * @brief Record an object sprite
+ * @param drawList Draw list of the frame
  * @param tilePosition dPiece coordinates
  * @param targetBufferPosition Output buffer coordinates
  * @param pre Is the sprite in the background
  */
-void DrawObject(const Surface &out, Point tilePosition, Point targetBufferPosition, bool pre)
+void DrawObject(DrawList &drawList, Point tilePosition, Point targetBufferPosition, bool pre)
 {
 	if (LightTableIndex >= LightsMax) {
 		return;
@@ -480,25 +500,26 @@ void DrawObject(const Surface &out, Point tilePosition, Point targetBufferPositi
 		screenPosition -= worldOffset.worldToScreen();
 	}
 
+	const DrawLayer layer = pre ? DrawLayer::ObjectPre : DrawLayer::Object;
 	if (&objectToDraw == ObjectUnderCursor) {
-		ClxDrawOutlineSkipColorZero(out, 194, screenPosition, sprite);
+		drawList.addOutline(layer, 194, screenPosition, sprite);
 	}
 	if (objectToDraw._oLight) {
-		ClxDrawLight(out, screenPosition, sprite);
+		drawList.addSprite(layer, BlitMode::Light, screenPosition, sprite);
 	} else {
-		ClxDraw(out, screenPosition, sprite);
+		drawList.addSprite(layer, BlitMode::Plain, screenPosition, sprite);
 	}
 }
 
-static void DrawDungeon(const Surface & /*out*/, Point /*tilePosition*/, Point /*targetBufferPosition*/);
+static void DrawDungeon(DrawList & /*drawList*/, Point /*tilePosition*/, Point /*targetBufferPosition*/);
 
 /**
- * @brief Render a cell
- * @param out Target buffer
+ * @brief Record the level CEL blocks of a cell
+ * @param drawList Draw list of the frame
  * @param tilePosition dPiece coordinates
  * @param targetBufferPosition Target buffer coordinates
  */
-void DrawCell(const Surface &out, Point tilePosition, Point targetBufferPosition)
+void DrawCell(DrawList &drawList, Point tilePosition, Point targetBufferPosition)
 {
 	const uint16_t levelPieceId = dPiece[tilePosition.x][tilePosition.y];
 	const MICROS *pMap = &DPieceMicros[levelPieceId];
@@ -557,7 +578,7 @@ void DrawCell(const Surface &out, Point tilePosition, Point targetBufferPosition
 			const MaskType maskType = getFirstTileMaskLeft(tileType);
 			if (levelCelBlock.hasValue()) {
 				if (maskType != MaskType::LeftFoliage || tileType == TileType::TransparentSquare) {
-					RenderTile(out, targetBufferPosition,
+					drawList.addTile(targetBufferPosition,
 					    levelCelBlock, maskType, LightTableIndex);
 				}
 			}
@@ -569,7 +590,7 @@ void DrawCell(const Surface &out, Point tilePosition, Point targetBufferPosition
 			if (levelCelBlock.hasValue()) {
 				if (transparency || !foliage || levelCelBlock.type() == TileType::TransparentSquare) {
 					if (maskType != MaskType::RightFoliage || tileType == TileType::TransparentSquare) {
-						RenderTile(out, targetBufferPosition + Displacement { TILE_WIDTH / 2, 0 },
+						drawList.addTile(targetBufferPosition + Displacement { TILE_WIDTH / 2, 0 },
 						    levelCelBlock, maskType, LightTableIndex);
 					}
 				}
@@ -582,7 +603,7 @@ void DrawCell(const Surface &out, Point tilePosition, Point targetBufferPosition
 		{
 			const LevelCelBlock levelCelBlock { pMap->mt[i] };
 			if (levelCelBlock.hasValue()) {
-				RenderTile(out, targetBufferPosition,
+				drawList.addTile(targetBufferPosition,
 				    levelCelBlock,
 				    transparency ? MaskType::Transparent : MaskType::Solid, LightTableIndex);
 			}
@@ -590,7 +611,7 @@ void DrawCell(const Surface &out, Point tilePosition, Point targetBufferPosition
 		{
 			const LevelCelBlock levelCelBlock { pMap->mt[i + 1] };
 			if (levelCelBlock.hasValue()) {
-				RenderTile(out, targetBufferPosition + Displacement { TILE_WIDTH / 2, 0 },
+				drawList.addTile(targetBufferPosition + Displacement { TILE_WIDTH / 2, 0 },
 				    levelCelBlock,
 				    transparency ? MaskType::Transparent : MaskType::Solid, LightTableIndex);
 			}
@@ -600,40 +621,40 @@ void DrawCell(const Surface &out, Point tilePosition, Point targetBufferPosition
 }
 
 /**
- * @brief Render a floor tile.
- * @param out Target buffer
+ * @brief Record a floor tile.
+ * @param drawList Draw list of the frame
  * @param tilePosition dPiece coordinates
  * @param targetBufferPosition Target buffer coordinate
  */
-void DrawFloor(const Surface &out, Point tilePosition, Point targetBufferPosition)
+void DrawFloor(DrawList &drawList, Point tilePosition, Point targetBufferPosition)
 {
-	LightTableIndex = dLight[tilePosition.x][tilePosition.y];
+	const uint8_t lightTableIndex = dLight[tilePosition.x][tilePosition.y];
 
 	const uint16_t levelPieceId = dPiece[tilePosition.x][tilePosition.y];
 	{
 		const LevelCelBlock levelCelBlock { DPieceMicros[levelPieceId].mt[0] };
 		if (levelCelBlock.hasValue()) {
-			RenderTile(out, targetBufferPosition,
-			    levelCelBlock, MaskType::Solid, LightTableIndex);
+			drawList.addTile(targetBufferPosition,
+			    levelCelBlock, MaskType::Solid, lightTableIndex);
 		}
 	}
 	{
 		const LevelCelBlock levelCelBlock { DPieceMicros[levelPieceId].mt[1] };
 		if (levelCelBlock.hasValue()) {
-			RenderTile(out, targetBufferPosition + Displacement { TILE_WIDTH / 2, 0 },
-			    levelCelBlock, MaskType::Solid, LightTableIndex);
+			drawList.addTile(targetBufferPosition + Displacement { TILE_WIDTH / 2, 0 },
+			    levelCelBlock, MaskType::Solid, lightTableIndex);
 		}
 	}
 }
 
 /**
- * @brief Draw item for a given tile
- * @param out Output buffer
+ * @brief Record the item for a given tile
+ * @param drawList Draw list of the frame
  * @param tilePosition dPiece coordinates
  * @param targetBufferPosition Output buffer coordinates
  * @param pre Is the sprite in the background
  */
-void DrawItem(const Surface &out, Point tilePosition, Point targetBufferPosition, bool pre)
+void DrawItem(DrawList &drawList, Point tilePosition, Point targetBufferPosition, bool pre)
 {
 	int8_t bItem = dItem[tilePosition.x][tilePosition.y];
 
@@ -644,24 +665,25 @@ void DrawItem(const Surface &out, Point tilePosition, Point targetBufferPosition
 	if (item._iPostDraw == pre)
 		return;
 
+	const DrawLayer layer = pre ? DrawLayer::ItemPre : DrawLayer::Item;
 	const ClxSprite sprite = item.AnimInfo.currentSprite();
 	int px = targetBufferPosition.x - CalculateWidth2(sprite.width());
 	const Point position { px, targetBufferPosition.y };
 	if (stextflag == TalkID::None && (bItem - 1 == pcursitem || AutoMapShowItems)) {
-		ClxDrawOutlineSkipColorZero(out, GetOutlineColor(item, false), position, sprite);
+		drawList.addOutline(layer, GetOutlineColor(item, false), position, sprite);
 	}
-	ClxDrawLight(out, position, sprite);
+	drawList.addSprite(layer, BlitMode::Light, position, sprite);
 	if (item.AnimInfo.isLastFrame() || item._iCurs == ICURS_MAGIC_ROCK)
 		AddItemToLabelQueue(bItem - 1, position);
 }
 
 /**
  * @brief Check if and how a monster should be rendered
- * @param out Output buffer
+ * @param drawList Draw list of the frame
  * @param tilePosition dPiece coordinates
  * @param targetBufferPosition Output buffer coordinates
  */
-void DrawMonsterHelper(const Surface &out, Point tilePosition, Point targetBufferPosition)
+void DrawMonsterHelper(DrawList &drawList, Point tilePosition, Point targetBufferPosition)
 {
 	int mi = dMonster[tilePosition.x][tilePosition.y];
 	bool isNegativeMonster = mi < 0;
@@ -675,9 +697,9 @@ void DrawMonsterHelper(const Surface &out, Point tilePosition, Point targetBuffe
 		const Point position { px, targetBufferPosition.y };
 		const ClxSprite sprite = towner.currentSprite();
 		if (mi == pcursmonst) {
-			ClxDrawOutlineSkipColorZero(out, 166, position, sprite);
+			drawList.addOutline(DrawLayer::Monster, 166, position, sprite);
 		}
-		ClxDraw(out, position, sprite);
+		drawList.addSprite(DrawLayer::Monster, BlitMode::Plain, position, sprite);
 		return;
 	}
 
@@ -712,19 +734,19 @@ void DrawMonsterHelper(const Surface &out, Point tilePosition, Point targetBuffe
 
 	const Point monsterRenderPosition { targetBufferPosition + offset - Displacement { CalculateWidth2(sprite.width()), 0 } };
 	if (mi == pcursmonst) {
-		ClxDrawOutlineSkipColorZero(out, 233, monsterRenderPosition, sprite);
+		drawList.addOutline(DrawLayer::Monster, 233, monsterRenderPosition, sprite);
 	}
-	DrawMonster(out, tilePosition, monsterRenderPosition, monster);
+	DrawMonster(drawList, tilePosition, monsterRenderPosition, monster);
 }
 
 /**
  * @brief Check if and how a player should be rendered
- * @param out Output buffer
+ * @param drawList Draw list of the frame
  * @param player Player reference
  * @param tilePosition dPiece coordinates
  * @param targetBufferPosition Output buffer coordinates
  */
-void DrawPlayerHelper(const Surface &out, const Player &player, Point tilePosition, Point targetBufferPosition)
+void DrawPlayerHelper(DrawList &drawList, const Player &player, Point tilePosition, Point targetBufferPosition)
 {
 	Displacement offset = {};
 	if (player.isWalking()) {
@@ -733,16 +755,16 @@ void DrawPlayerHelper(const Surface &out, const Player &player, Point tilePositi
 
 	const Point playerRenderPosition { targetBufferPosition + offset };
 
-	DrawPlayer(out, player, tilePosition, playerRenderPosition);
+	DrawPlayer(drawList, DrawLayer::Player, player, tilePosition, playerRenderPosition);
 }
 
 /**
- * @brief Render object sprites
- * @param out Target buffer
+ * @brief Record the contents of a tile
+ * @param drawList Draw list of the frame
  * @param tilePosition dPiece coordinates
  * @param targetBufferPosition Target buffer coordinates
  */
-void DrawDungeon(const Surface &out, Point tilePosition, Point targetBufferPosition)
+void DrawDungeon(DrawList &drawList, Point tilePosition, Point targetBufferPosition)
 {
 	assert(InDungeonBounds(tilePosition));
 
@@ -752,19 +774,20 @@ void DrawDungeon(const Surface &out, Point tilePosition, Point targetBufferPosit
 
 	LightTableIndex = dLight[tilePosition.x][tilePosition.y];
 
-	DrawCell(out, tilePosition, targetBufferPosition);
+	drawList.nextTile();
+	DrawCell(drawList, tilePosition, targetBufferPosition);
 
 	int8_t bDead = dCorpse[tilePosition.x][tilePosition.y];
 	int8_t bMap = dTransVal[tilePosition.x][tilePosition.y];
 
 #ifdef _DEBUG
 	if (DebugVision && IsTileLit(tilePosition)) {
-		ClxDraw(out, targetBufferPosition, (*pSquareCel)[0]);
+		drawList.addSprite(DrawLayer::Debug, BlitMode::Plain, targetBufferPosition, (*pSquareCel)[0]);
 	}
 #endif
 
 	if (MissilePreFlag) {
-		DrawMissile(out, tilePosition, targetBufferPosition, true);
+		DrawMissile(drawList, tilePosition, targetBufferPosition, true);
 	}
 
 	if (LightTableIndex < LightsMax && bDead != 0) {
@@ -774,28 +797,28 @@ void DrawDungeon(const Surface &out, Point tilePosition, Point targetBufferPosit
 			const ClxSprite sprite = corpse.spritesForDirection(static_cast<Direction>((bDead >> 5) & 7))[corpse.frame];
 			if (corpse.translationPaletteIndex != 0) {
 				const uint8_t *trn = Monsters[corpse.translationPaletteIndex - 1].uniqueMonsterTRN.get();
-				ClxDrawTRN(out, position, sprite, trn);
+				drawList.addSprite(DrawLayer::Corpse, BlitMode::TRN, position, sprite, trn);
 			} else {
-				ClxDrawLight(out, position, sprite);
+				drawList.addSprite(DrawLayer::Corpse, BlitMode::Light, position, sprite);
 			}
 		} while (false);
 	}
-	DrawObject(out, tilePosition, targetBufferPosition, true);
-	DrawItem(out, tilePosition, targetBufferPosition, true);
+	DrawObject(drawList, tilePosition, targetBufferPosition, true);
+	DrawItem(drawList, tilePosition, targetBufferPosition, true);
 
 	if (TileContainsDeadPlayer(tilePosition)) {
-		DrawDeadPlayer(out, tilePosition, targetBufferPosition);
+		DrawDeadPlayer(drawList, tilePosition, targetBufferPosition);
 	}
 	int8_t playerId = dPlayer[tilePosition.x][tilePosition.y];
 	if (static_cast<size_t>(playerId - 1) < Players.size()) {
-		DrawPlayerHelper(out, Players[playerId - 1], tilePosition, targetBufferPosition);
+		DrawPlayerHelper(drawList, Players[playerId - 1], tilePosition, targetBufferPosition);
 	}
 	if (dMonster[tilePosition.x][tilePosition.y] != 0) {
-		DrawMonsterHelper(out, tilePosition, targetBufferPosition);
+		DrawMonsterHelper(drawList, tilePosition, targetBufferPosition);
 	}
-	DrawMissile(out, tilePosition, targetBufferPosition, false);
-	DrawObject(out, tilePosition, targetBufferPosition, false);
-	DrawItem(out, tilePosition, targetBufferPosition, false);
+	DrawMissile(drawList, tilePosition, targetBufferPosition, false);
+	DrawObject(drawList, tilePosition, targetBufferPosition, false);
+	DrawItem(drawList, tilePosition, targetBufferPosition, false);
 
 	if (leveltype != DTYPE_TOWN) {
 		char bArch = dSpecial[tilePosition.x][tilePosition.y];
@@ -806,9 +829,9 @@ void DrawDungeon(const Surface &out, Point tilePosition, Point targetBufferPosit
 			transparency = transparency && (SDL_GetModState() & KMOD_ALT) == 0;
 #endif
 			if (transparency) {
-				ClxDrawLightBlended(out, targetBufferPosition, (*pSpecialCels)[bArch - 1]);
+				drawList.addSprite(DrawLayer::Special, BlitMode::LightBlended, targetBufferPosition, (*pSpecialCels)[bArch - 1]);
 			} else {
-				ClxDrawLight(out, targetBufferPosition, (*pSpecialCels)[bArch - 1]);
+				drawList.addSprite(DrawLayer::Special, BlitMode::Light, targetBufferPosition, (*pSpecialCels)[bArch - 1]);
 			}
 		}
 	} else {
@@ -818,29 +841,29 @@ void DrawDungeon(const Surface &out, Point tilePosition, Point targetBufferPosit
 		if (tilePosition.x > 0 && tilePosition.y > 0 && targetBufferPosition.y > TILE_HEIGHT) {
 			char bArch = dSpecial[tilePosition.x - 1][tilePosition.y - 1];
 			if (bArch != 0) {
-				ClxDraw(out, targetBufferPosition + Displacement { 0, -TILE_HEIGHT }, (*pSpecialCels)[bArch - 1]);
+				drawList.addSprite(DrawLayer::Special, BlitMode::Plain, targetBufferPosition + Displacement { 0, -TILE_HEIGHT }, (*pSpecialCels)[bArch - 1]);
 			}
 		}
 	}
 }
 
 /**
- * @brief Render a row of tiles
- * @param out Buffer to render to
+ * @brief Record the floor of a row of tiles
+ * @param drawList Draw list of the frame
  * @param tilePosition dPiece coordinates
  * @param targetBufferPosition Target buffer coordinates
  * @param rows Number of rows
  * @param columns Tile in a row
  */
-void DrawFloor(const Surface &out, Point tilePosition, Point targetBufferPosition, int rows, int columns)
+void DrawFloor(DrawList &drawList, Point tilePosition, Point targetBufferPosition, int rows, int columns)
 {
 	for (int i = 0; i < rows; i++) {
 		for (int j = 0; j < columns; j++) {
 			if (InDungeonBounds(tilePosition)) {
 				if (!TileHasAny(dPiece[tilePosition.x][tilePosition.y], TileProperties::Solid))
-					DrawFloor(out, tilePosition, targetBufferPosition);
+					DrawFloor(drawList, tilePosition, targetBufferPosition);
 			} else {
-				world_draw_black_tile(out, targetBufferPosition.x, targetBufferPosition.y);
+				drawList.addBlackTile(targetBufferPosition);
 			}
 			tilePosition += Direction::East;
 			targetBufferPosition.x += TILE_WIDTH;
@@ -869,18 +892,23 @@ bool IsWall(Point position)
 }
 
 /**
- * @brief Render a row of tile
- * @param out Output buffer
+ * @brief Record the floor and the contents of the tiles in view into `FrameDrawList`
  * @param tilePosition dPiece coordinates
  * @param targetBufferPosition Buffer coordinates
  * @param rows Number of rows
  * @param columns Tile in a row
  */
-void DrawTileContent(const Surface &out, Point tilePosition, Point targetBufferPosition, int rows, int columns)
+void RecordTileContent(Point tilePosition, Point targetBufferPosition, int rows, int columns)
 {
+#ifdef _DEBUG
+	DebugCoordsMap.clear();
+#endif
+	dRendered.reset();
+	FrameDrawList.clear();
+	DrawFloor(FrameDrawList, tilePosition, targetBufferPosition, rows, columns);
+
 	// Keep evaluating until MicroTiles can't affect screen
 	rows += MicroTileLen;
-	dRendered.reset();
 
 	for (int i = 0; i < rows; i++) {
 		for (int j = 0; j < columns; j++) {
@@ -895,11 +923,11 @@ void DrawTileContent(const Surface &out, Point tilePosition, Point targetBufferP
 					// sprite screen position rather than tile position.
 					if (IsWall(tilePosition) && (IsWall(tilePosition + Displacement { 1, 0 }) || (tilePosition.x > 0 && IsWall(tilePosition + Displacement { -1, 0 })))) { // Part of a wall aligned on the x-axis
 						if (IsTileNotSolid(tilePosition + Displacement { 1, -1 }) && IsTileNotSolid(tilePosition + Displacement { 0, -1 })) {                              // Has walkable area behind it
-							DrawDungeon(out, tilePosition + Direction::East, { targetBufferPosition.x + TILE_WIDTH, targetBufferPosition.y });
+							DrawDungeon(FrameDrawList, tilePosition + Direction::East, { targetBufferPosition.x + TILE_WIDTH, targetBufferPosition.y });
 						}
 					}
 				}
-				DrawDungeon(out, tilePosition, targetBufferPosition);
+				DrawDungeon(FrameDrawList, tilePosition, targetBufferPosition);
 			}
 			tilePosition += Direction::East;
 			targetBufferPosition.x += TILE_WIDTH;
@@ -920,24 +948,66 @@ void DrawTileContent(const Surface &out, Point tilePosition, Point targetBufferP
 			targetBufferPosition.x -= TILE_WIDTH / 2;
 		}
 	}
+
+	FrameDrawList.sort();
 }
 
 /**
- * @brief Scale up the top left part of the buffer 2x.
+ * @brief Returns the helper threads for rendering the game view, or nullptr when rendering on a single thread.
  */
-void Zoom(const Surface &out)
+WorkerPool *GetRenderWorkers()
 {
-	int viewportWidth = out.w();
-	int viewportOffsetX = 0;
-	if (CanPanelsCoverView()) {
-		if (IsLeftPanelOpen()) {
-			viewportWidth -= SidePanelSize.width;
-			viewportOffsetX = SidePanelSize.width;
-		} else if (IsRightPanelOpen()) {
-			viewportWidth -= SidePanelSize.width;
-		}
+#ifdef DUN_RENDER_STATS
+	// The statistics are not synchronized.
+	return nullptr;
+#else
+	const unsigned numWorkers = static_cast<unsigned>(std::max(*sgOptions.Graphics.renderThreads, 1) - 1);
+	if (numWorkers == 0) {
+		RenderWorkers = nullptr;
+		return nullptr;
+	}
+	if (RenderWorkers == nullptr || RenderWorkers->size() != numWorkers)
+		RenderWorkers = std::make_unique<WorkerPool>(numWorkers);
+	return RenderWorkers.get();
+#endif
+}
+
+/**
+ * @brief Render the recorded floor and tile contents
+ *
+ * With more than one render thread the buffer is split into horizontal bands
+ * that are rendered in parallel. Each band only touches its own rows, so the
+ * result is identical to rendering the whole buffer at once.
+ *
+ * @param out Buffer to render to
+ */
+void DrawTileContent(const Surface &out)
+{
+	WorkerPool *workers = GetRenderWorkers();
+	if (workers == nullptr) {
+		FrameDrawList.submit(out);
+		return;
 	}
 
+	const int numBands = static_cast<int>(workers->size()) + 1;
+	const int bandHeight = (out.h() + numBands - 1) / numBands;
+	workers->parallelFor(numBands, [&](unsigned band) {
+		const int top = static_cast<int>(band) * bandHeight;
+		const int height = std::min(bandHeight, out.h() - top);
+		if (height <= 0)
+			return;
+		FrameDrawList.submit(out.subregionY(top, height), { 0, -top });
+	});
+}
+
+/**
+ * @brief Scale up the top left part of the buffer 2x.
+ * @param out Buffer to scale up
+ * @param viewportWidth Width of the part of the buffer not covered by side panels
+ * @param viewportOffsetX Left edge of the part of the buffer not covered by side panels
+ */
+void Zoom(const Surface &out, int viewportWidth, int viewportOffsetX)
+{
 	// We round to even for the source width and height.
 	// If the width / height was odd, we copy just one extra pixel / row later on.
 	const int srcWidth = (viewportWidth + 1) / 2;
@@ -1028,18 +1098,128 @@ void CalcFirstTilePosition(Point &position, Displacement &offset)
 }
 
 /**
- * @brief Configure render and process screen rows
+ * @brief Where `FrameDrawList` is rendered to, captured together with the list.
+ */
+struct GameViewTarget {
+	/** @brief Buffer area the view is rendered to, the top left quarter of the view area when zoomed. */
+	Surface out;
+	/** @brief The view area that `out` is scaled up to, if zoomed. */
+	std::optional<Surface> zoomOut;
+	/** @brief Arguments for `Zoom`. */
+	int zoomWidth;
+	int zoomOffsetX;
+};
+
+/**
+ * @brief The view that the background thread is rendering.
+ */
+GameViewTarget PendingGameView;
+
+/**
+ * @brief Renders game views on a background thread, see `GraphicsOptions::pipelinedRendering`.
+ */
+class GameViewPipeline {
+public:
+	GameViewPipeline()
+	    : thread_(ThreadMain, this)
+	{
+	}
+
+	~GameViewPipeline()
+	{
+		mutex_.lock();
+		quit_ = true;
+		workAvailable_.signal();
+		mutex_.unlock();
+		thread_.join();
+	}
+
+	GameViewPipeline(const GameViewPipeline &) = delete;
+	GameViewPipeline &operator=(const GameViewPipeline &) = delete;
+
+	/**
+	 * @brief Starts rendering `FrameDrawList` to the given target, neither may be touched until `wait` returns.
+	 */
+	void start(const GameViewTarget &target)
+	{
+		mutex_.lock();
+		target_ = &target;
+		busy_ = true;
+		workAvailable_.signal();
+		mutex_.unlock();
+	}
+
+	/**
+	 * @brief Blocks until the view started last has been rendered.
+	 */
+	void wait()
+	{
+		mutex_.lock();
+		while (busy_)
+			workDone_.wait(mutex_);
+		mutex_.unlock();
+	}
+
+private:
+	static int SDLCALL ThreadMain(void *data);
+
+	SdlMutex mutex_;
+	SdlCond workAvailable_;
+	SdlCond workDone_;
+	const GameViewTarget *target_ = nullptr;
+	bool busy_ = false;
+	bool quit_ = false;
+	// Declared last so that the thread starts once everything else is initialized.
+	SdlThread thread_;
+};
+
+std::unique_ptr<GameViewPipeline> ViewPipeline;
+
+/** @brief Whether `ViewPipeline` is rendering `PendingGameView`. */
+bool GameViewPending;
+
+/** @brief Whether the back buffer already holds the game view for the next `DrawGame`. */
+bool GameViewRendered;
+
+bool UsePipelinedRendering()
+{
+#ifdef DUN_RENDER_STATS
+	// The statistics are drawn on top of the view of the same frame.
+	return false;
+#else
+	return *sgOptions.Graphics.pipelinedRendering;
+#endif
+}
+
+/**
+ * @brief Record the game view, reading all the game state that rendering it needs
  * @param fullOut Buffer to render to
  * @param position First tile of view in dPiece coordinate
  * @param offset Amount to offset the rendering in screen space
  */
-void DrawGame(const Surface &fullOut, Point position, Displacement offset)
+GameViewTarget RecordGameView(const Surface &fullOut, Point position, Displacement offset)
 {
+	GameViewTarget target;
+
 	// Limit rendering to the view area
-	const Surface &out = !*sgOptions.Graphics.zoom
+	target.out = !*sgOptions.Graphics.zoom
 	    ? fullOut.subregionY(0, gnViewportHeight)
 	    : fullOut.subregionY(0, (gnViewportHeight + 1) / 2);
 
+	if (*sgOptions.Graphics.zoom) {
+		target.zoomOut = fullOut.subregionY(0, gnViewportHeight);
+		target.zoomWidth = target.zoomOut->w();
+		target.zoomOffsetX = 0;
+		if (CanPanelsCoverView()) {
+			if (IsLeftPanelOpen()) {
+				target.zoomWidth -= SidePanelSize.width;
+				target.zoomOffsetX = SidePanelSize.width;
+			} else if (IsRightPanelOpen()) {
+				target.zoomWidth -= SidePanelSize.width;
+			}
+		}
+	}
+
 	int columns = tileColums;
 	int rows = tileRows;
 
@@ -1076,18 +1256,93 @@ void DrawGame(const Surface &fullOut, Point position, Displacement offset)
 		}
 	}
 
+	RecordTileContent(position, Point {} + offset, rows, columns);
+
+	return target;
+}
+
+/**
+ * @brief Render a recorded game view, does not read any game state
+ */
+void RenderGameView(const GameViewTarget &target)
+{
+	BeginTileLightCacheFrame();
+
+	DrawTileContent(target.out);
+
+	if (target.zoomOut) {
+		Zoom(*target.zoomOut, target.zoomWidth, target.zoomOffsetX);
+	}
+}
+
+int SDLCALL GameViewPipeline::ThreadMain(void *data)
+{
+	auto &pipeline = *static_cast<GameViewPipeline *>(data);
+	pipeline.mutex_.lock();
+	while (true) {
+		while (!pipeline.quit_ && pipeline.target_ == nullptr)
+			pipeline.workAvailable_.wait(pipeline.mutex_);
+		if (pipeline.quit_)
+			break;
+		const GameViewTarget &target = *pipeline.target_;
+		pipeline.target_ = nullptr;
+		pipeline.mutex_.unlock();
+		RenderGameView(target);
+		pipeline.mutex_.lock();
+		pipeline.busy_ = false;
+		pipeline.workDone_.broadcast();
+	}
+	pipeline.mutex_.unlock();
+	return 0;
+}
+
+/**
+ * @brief Record the game view from the current game state and start rendering it in the background.
+ *
+ * It is shown by the next `DrawAndBlit`, while the game logic in between runs in parallel.
+ */
+void StartGameViewRendering(const Surface &out)
+{
+	if (ViewPipeline == nullptr)
+		ViewPipeline = std::make_unique<GameViewPipeline>();
+
+	// The cursor is restored now, restoring it later would overwrite the new view.
+	UndrawCursor(out);
+
+	nthread_UpdateProgressToNextGameTick();
+	Point position = ViewPosition;
+	Displacement offset = {};
+	CalcFirstTilePosition(position, offset);
+	PendingGameView = RecordGameView(out, position, offset);
+	ViewPipeline->start(PendingGameView);
+	GameViewPending = true;
+}
+
+/**
+ * @brief Configure render and process screen rows
+ * @param fullOut Buffer to render to
+ * @param position First tile of view in dPiece coordinate
+ * @param offset Amount to offset the rendering in screen space
+ */
+void DrawGame(const Surface &fullOut, Point position, Displacement offset)
+{
 #ifdef DUN_RENDER_STATS
 	DunRenderStats.clear();
+	TileLightCacheHits = 0;
+	TileLightCacheMisses = 0;
 #endif
 
-	DrawFloor(out, position, Point {} + offset, rows, columns);
-	DrawTileContent(out, position, Point {} + offset, rows, columns);
-
-	if (*sgOptions.Graphics.zoom) {
-		Zoom(fullOut.subregionY(0, gnViewportHeight));
+	if (GameViewRendered) {
+		GameViewRendered = false;
+	} else {
+		RenderGameView(RecordGameView(fullOut, position, offset));
 	}
 
 #ifdef DUN_RENDER_STATS
+	const Surface &out = !*sgOptions.Graphics.zoom
+	    ? fullOut.subregionY(0, gnViewportHeight)
+	    : fullOut.subregionY(0, (gnViewportHeight + 1) / 2);
+
 	std::vector<std::pair<DunRenderType, size_t>> sortedStats(DunRenderStats.begin(), DunRenderStats.end());
 	std::sort(sortedStats.begin(), sortedStats.end(),
 	    [](const std::pair<DunRenderType, size_t> &a, const std::pair<DunRenderType, size_t> &b) {
@@ -1104,6 +1359,11 @@ void DrawGame(const Surface &fullOut, Point position, Displacement offset)
 		DrawString(out, FormatInteger(stat.second), Rectangle({ pos.x + 354, pos.y }, Size(40, 16)), UiFlags::AlignRight);
 		pos.y += 16;
 	}
+	DrawString(out, "Lit tile cache hits", { pos.x + 24, pos.y });
+	DrawString(out, FormatInteger(TileLightCacheHits), Rectangle({ pos.x + 354, pos.y }, Size(40, 16)), UiFlags::AlignRight);
+	pos.y += 16;
+	DrawString(out, "Lit tile cache misses", { pos.x + 24, pos.y });
+	DrawString(out, FormatInteger(TileLightCacheMisses), Rectangle({ pos.x + 354, pos.y }, Size(40, 16)), UiFlags::AlignRight);
 #endif
 }
 
@@ -1114,9 +1374,6 @@ void DrawGame(const Surface &fullOut, Point position, Displacement offset)
  */
 void DrawView(const Surface &out, Point startPosition)
 {
-#ifdef _DEBUG
-	DebugCoordsMap.clear();
-#endif
 	Displacement offset = {};
 	CalcFirstTilePosition(startPosition, offset);
 	DrawGame(out, startPosition, offset);
@@ -1247,12 +1504,13 @@ void DrawView(const Surface &out, Point startPosition)
 }
 
 /**
- * @brief Display the current average FPS over 1 sec
+ * @brief Display the current average FPS over 1 sec, and the input latency if there was any input
  */
 void DrawFPS(const Surface &out)
 {
 	static int framesSinceLastUpdate = 0;
 	static string_view formatted {};
+	static string_view formattedLatency {};
 
 	if (!frameflag || !gbActive) {
 		return;
@@ -1272,8 +1530,17 @@ void DrawFPS(const Surface &out)
 		    ? BufCopy(buf, fps / FpsPow10, " FPS")
 		    : BufCopy(buf, fps / FpsPow10, ".", fps % FpsPow10, " FPS");
 		formatted = { buf, static_cast<string_view::size_type>(end - buf) };
+
+		formattedLatency = {};
+		if (const std::optional<InputLatency> latency = GetInputLatency()) {
+			static char latencyBuf[40] {};
+			end = BufCopy(latencyBuf, "Input ", latency->averageMs, " ms, max ", latency->maxMs, " ms");
+			formattedLatency = { latencyBuf, static_cast<string_view::size_type>(end - latencyBuf) };
+		}
 	};
 	DrawString(out, formatted, Point { 8, 68 }, UiFlags::ColorRed);
+	if (!formattedLatency.empty())
+		DrawString(out, formattedLatency, Point { 8, 82 }, UiFlags::ColorRed);
 }
 
 /**
@@ -1592,6 +1859,8 @@ void scrollrt_draw_game_screen()
 	if (HeadlessMode)
 		return;
 
+	DiscardGameViewRendering();
+
 	int hgt = 0;
 
 	if (IsRedrawEverything()) {
@@ -1607,7 +1876,7 @@ void scrollrt_draw_game_screen()
 	RenderPresent();
 }
 
-void DrawAndBlit()
+void DrawAndBlit(bool startNextView)
 {
 	if (!gbRunGame || HeadlessMode) {
 		return;
@@ -1638,8 +1907,11 @@ void DrawAndBlit()
 		hgt = gnViewportHeight;
 	}
 
+	WaitForGameViewRendering();
+
 	const Surface &out = GlobalBackBuffer();
-	UndrawCursor(out);
+	if (!GameViewRendered)
+		UndrawCursor(out);
 
 	nthread_UpdateProgressToNextGameTick();
 
@@ -1683,7 +1955,36 @@ void DrawAndBlit()
 		}
 	}
 
+	// Before the next view starts rendering to the back buffer.
+	CaptureFrame();
+
 	RenderPresent();
+
+	if (startNextView && UsePipelinedRendering())
+		StartGameViewRendering(GlobalBackBuffer());
+	else
+		ViewPipeline = nullptr;
+}
+
+void WaitForGameViewRendering()
+{
+	if (!GameViewPending)
+		return;
+	ViewPipeline->wait();
+	GameViewPending = false;
+	GameViewRendered = true;
+}
+
+void DiscardGameViewRendering()
+{
+	WaitForGameViewRendering();
+	GameViewRendered = false;
+}
+
+void StopGameViewRendering()
+{
+	DiscardGameViewRendering();
+	ViewPipeline = nullptr;
 }
 
 } // namespace devilution
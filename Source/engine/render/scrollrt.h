@@ -84,7 +84,25 @@ void scrollrt_draw_game_screen();
 
 /**
  * @brief Render the game
+ * @param startNextView Whether the next game view may be rendered in the background once this frame is shown
  */
-void DrawAndBlit();
+void DrawAndBlit(bool startNextView = true);
+
+/**
+ * @brief Block until the game view that is rendered in the background is done, it is shown by the next `DrawAndBlit`
+ */
+void WaitForGameViewRendering();
+
+/**
+ * @brief Block until the game view that is rendered in the background is done and drop it
+ *
+ * Has to be called before the back buffer is drawn to outside of `DrawAndBlit`.
+ */
+void DiscardGameViewRendering();
+
+/**
+ * @brief Drop the game view that is rendered in the background and stop the render thread, called when the game ends
+ */
+void StopGameViewRendering();
 
 } // namespace devilution
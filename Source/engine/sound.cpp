@@ -5,10 +5,10 @@
  */
 #include "engine/sound.h"
 
+#include <array>
+#include <atomic>
 #include <cstdint>
-#include <list>
 #include <memory>
-#include <mutex>
 
 #include <SDL.h>
 
@@ -17,9 +17,7 @@
 #include "options.h"
 #include "utils/log.hpp"
 #include "utils/math.h"
-#include "utils/sdl_mutex.h"
 #include "utils/stdcompat/algorithm.hpp"
-#include "utils/stdcompat/optional.hpp"
 #include "utils/stdcompat/shared_ptr_array.hpp"
 #include "utils/str_cat.hpp"
 #include "utils/stubs.h"
@@ -104,27 +102,39 @@ bool LoadAudioFile(const char *path, bool stream, bool errorDialog, SoundSample
 	return true;
 }
 
-std::list<std::unique_ptr<SoundSample>> duplicateSounds;
-std::optional<SdlMutex> duplicateSoundsMutex;
+/** Maximum number of overlapping plays of sound effects that are already playing. */
+constexpr size_t MaxDuplicateVoices = 32;
+
+/**
+ * @brief A preallocated voice for overlapping plays of a sound effect.
+ *
+ * The game thread claims a voice by setting `active`, the audio thread releases it
+ * from the finish callback, so neither side has to lock or allocate.
+ */
+struct DuplicateVoice {
+	SoundSample sample;
+	std::atomic<bool> active { false };
+};
+
+std::array<DuplicateVoice, MaxDuplicateVoices> duplicateVoices;
 
 SoundSample *DuplicateSound(const SoundSample &sound)
 {
-	auto duplicate = std::make_unique<SoundSample>();
-	if (duplicate->DuplicateFrom(sound) != 0)
-		return nullptr;
-	auto *result = duplicate.get();
-	decltype(duplicateSounds.begin()) it;
-	{
-		const std::lock_guard<SdlMutex> lock(*duplicateSoundsMutex);
-		duplicateSounds.push_back(std::move(duplicate));
-		it = duplicateSounds.end();
-		--it;
+	for (DuplicateVoice &voice : duplicateVoices) {
+		bool expected = false;
+		if (!voice.active.compare_exchange_strong(expected, true, std::memory_order_acquire))
+			continue;
+		if (voice.sample.DuplicateFrom(sound) != 0) {
+			voice.active.store(false, std::memory_order_release);
+			return nullptr;
+		}
+		voice.sample.SetFinishCallback([&voice]([[maybe_unused]] Aulib::Stream &stream) {
+			voice.active.store(false, std::memory_order_release);
+		});
+		return &voice.sample;
 	}
-	result->SetFinishCallback([it]([[maybe_unused]] Aulib::Stream &stream) {
-		const std::lock_guard<SdlMutex> lock(*duplicateSoundsMutex);
-		duplicateSounds.erase(it);
-	});
-	return result;
+	LogVerbose(LogCategory::Audio, "All {} duplicate voices are in use", MaxDuplicateVoices);
+	return nullptr;
 }
 
 /** Maps from track ID to track name in spawn. */
@@ -159,8 +169,11 @@ int CapVolume(int volume)
 
 void ClearDuplicateSounds()
 {
-	const std::lock_guard<SdlMutex> lock(*duplicateSoundsMutex);
-	duplicateSounds.clear();
+	for (DuplicateVoice &voice : duplicateVoices) {
+		if (voice.sample.IsLoaded())
+			voice.sample.Stop();
+		voice.active.store(false, std::memory_order_release);
+	}
 }
 
 void snd_play_snd(TSnd *pSnd, int lVolume, int lPan)
@@ -221,15 +234,17 @@ void snd_init()
 	LogVerbose(LogCategory::Audio, "Aulib sampleRate={} channels={} frameSize={} format={:#x}",
 	    Aulib::sampleRate(), Aulib::channelCount(), Aulib::frameSize(), Aulib::sampleFormat());
 
-	duplicateSoundsMutex.emplace();
 	gbSndInited = true;
 }
 
 void snd_deinit()
 {
 	if (gbSndInited) {
+		for (DuplicateVoice &voice : duplicateVoices) {
+			voice.sample.Release();
+			voice.active.store(false, std::memory_order_release);
+		}
 		Aulib::quit();
-		duplicateSoundsMutex = std::nullopt;
 	}
 
 	gbSndInited = false;
@@ -14,6 +14,7 @@
 #include "engine/demomode.h"
 #include "engine/dx.h"
 #include "engine/events.hpp"
+#include "engine/level_prefetch.hpp"
 #include "engine/load_cel.hpp"
 #include "engine/load_clx.hpp"
 #include "engine/load_pcx.hpp"
@@ -24,6 +25,7 @@
 #include "loadsave.h"
 #include "pfile.h"
 #include "plrmsg.h"
+#include "portal.h"
 #include "utils/sdl_geometry.h"
 #include "utils/stdcompat/optional.hpp"
 
@@ -109,6 +111,29 @@ Cutscenes PickCutscene(interface_mode uMsg)
 	}
 }
 
+/**
+ * @brief Returns the type of the level that `uMsg` leads to, or nullopt if it is only known once loaded.
+ */
+std::optional<dungeon_type> GetProgressLevelType(interface_mode uMsg)
+{
+	switch (uMsg) {
+	case WM_DIABNEXTLVL:
+	case WM_DIABPREVLVL:
+	case WM_DIABTOWNWARP:
+	case WM_DIABTWARPUP:
+	case WM_DIABRETOWN:
+		return GetLevelType(MyPlayer->plrlevel);
+	case WM_DIABSETLVL:
+		return setlvltype;
+	case WM_DIABRTNLVL:
+		return GetLevelType(GetMapReturnLevel());
+	case WM_DIABWARPLVL:
+		return GetPortalLevelType();
+	default:
+		return std::nullopt;
+	}
+}
+
 void LoadCutsceneBackground(interface_mode uMsg)
 {
 	const char *celPath;
@@ -279,8 +304,14 @@ void CompleteProgress()
 		IncProgress();
 }
 
+void PrefetchProgressLevel(interface_mode uMsg)
+{
+	StartLevelPrefetch(GetProgressLevelType(uMsg).value_or(DTYPE_NONE));
+}
+
 void ShowProgress(interface_mode uMsg)
 {
+	DiscardGameViewRendering();
 	IsProgress = true;
 
 	gbSomebodyWonGameKludge = false;
@@ -491,6 +522,8 @@ void ShowProgress(interface_mode uMsg)
 		PaletteFadeOut(8);
 	}
 
+	EndLevelPrefetch();
+
 	previousHandler = SetEventHandler(previousHandler);
 	assert(previousHandler == DisableInputEventHandler);
 	IsProgress = false;
@@ -55,6 +55,11 @@ enum Cutscenes : uint8_t {
 void interface_msg_pump();
 void IncProgress();
 void CompleteProgress();
+
+/**
+ * @brief Starts loading the assets of the level that `uMsg` leads to in the background, ahead of `ShowProgress`.
+ */
+void PrefetchProgressLevel(interface_mode uMsg);
 void ShowProgress(interface_mode uMsg);
 
 } // namespace devilution
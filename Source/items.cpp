@@ -12,6 +12,8 @@
 #endif
 #include <climits>
 #include <cstdint>
+#include <unordered_map>
+#include <vector>
 
 #include <fmt/core.h>
 #include <fmt/format.h>
@@ -55,7 +57,7 @@ uint8_t ActiveItemCount;
 int8_t dItem[MAXDUNX][MAXDUNY];
 bool ShowUniqueItemInfoBox;
 CornerStoneStruct CornerStone;
-bool UniqueItemFlags[128];
+thread_local bool UniqueItemFlags[128];
 int MaxGold = GOLD_MAX_LIMIT;
 
 /** Maps from item_cursor_graphic to in-memory item type. */
@@ -386,6 +388,70 @@ bool IsSuffixValidForItemType(int i, AffixItemType flgs)
 	return HasAnyOf(flgs, itemTypes);
 }
 
+/**
+ * @brief Affix candidate lists, keyed by the table and every filter they were built with.
+ *
+ * A list holds the eligible affix indices in table order, with double weighted prefixes listed twice, so that
+ * picking `l[GenerateRnd(size)]` consumes the RNG exactly like scanning the table on every roll did.
+ * Built per thread, so that items can be generated on several threads at once.
+ */
+thread_local std::unordered_map<uint64_t, std::vector<uint8_t>> AffixCandidates;
+
+uint64_t AffixCandidatesKey(bool suffix, AffixItemType flgs, int minlvl, int maxlvl, bool onlygood, bool excludeCharges, goodorevil goe)
+{
+	// PLMinLvl is an int8_t, so levels outside of that range select the same affixes as the nearest bound.
+	const auto clampLevel = [](int lvl) { return static_cast<uint64_t>(clamp(lvl, INT8_MIN - 1, INT8_MAX + 1) - (INT8_MIN - 1)); };
+	return static_cast<uint64_t>(suffix)
+	    | static_cast<uint64_t>(onlygood) << 1
+	    | static_cast<uint64_t>(excludeCharges) << 2
+	    | static_cast<uint64_t>(gbIsHellfire) << 3
+	    | static_cast<uint64_t>(goe) << 4
+	    | static_cast<uint64_t>(flgs) << 8
+	    | clampLevel(minlvl) << 16
+	    | clampLevel(maxlvl) << 32;
+}
+
+const std::vector<uint8_t> &GetPrefixCandidates(AffixItemType flgs, int minlvl, int maxlvl, bool onlygood, bool excludeCharges)
+{
+	const auto [it, inserted] = AffixCandidates.try_emplace(AffixCandidatesKey(false, flgs, minlvl, maxlvl, onlygood, excludeCharges, GOE_ANY));
+	std::vector<uint8_t> &l = it->second;
+	if (!inserted)
+		return l;
+
+	for (int j = 0; ItemPrefixes[j].power.type != IPL_INVALID; j++) {
+		if (!IsPrefixValidForItemType(j, flgs))
+			continue;
+		if (ItemPrefixes[j].PLMinLvl < minlvl || ItemPrefixes[j].PLMinLvl > maxlvl)
+			continue;
+		if (onlygood && !ItemPrefixes[j].PLOk)
+			continue;
+		if (excludeCharges && ItemPrefixes[j].power.type == IPL_CHARGES)
+			continue;
+		l.push_back(j);
+		if (ItemPrefixes[j].PLDouble)
+			l.push_back(j);
+	}
+	return l;
+}
+
+const std::vector<uint8_t> &GetSuffixCandidates(AffixItemType flgs, int minlvl, int maxlvl, bool onlygood, goodorevil goe)
+{
+	const auto [it, inserted] = AffixCandidates.try_emplace(AffixCandidatesKey(true, flgs, minlvl, maxlvl, onlygood, false, goe));
+	std::vector<uint8_t> &l = it->second;
+	if (!inserted)
+		return l;
+
+	for (int j = 0; ItemSuffixes[j].power.type != IPL_INVALID; j++) {
+		if (IsSuffixValidForItemType(j, flgs)
+		    && ItemSuffixes[j].PLMinLvl >= minlvl && ItemSuffixes[j].PLMinLvl <= maxlvl
+		    && !((goe == GOE_GOOD && ItemSuffixes[j].PLGOE == GOE_EVIL) || (goe == GOE_EVIL && ItemSuffixes[j].PLGOE == GOE_GOOD))
+		    && (!onlygood || ItemSuffixes[j].PLOk)) {
+			l.push_back(j);
+		}
+	}
+	return l;
+}
+
 int ItemsGetCurrlevel()
 {
 	if (setlevel) {
@@ -1082,22 +1148,9 @@ void GetStaffPower(const Player &player, Item &item, int lvl, SpellID bs, bool o
 {
 	int preidx = -1;
 	if (FlipCoin(10) || onlygood) {
-		int nl = 0;
-		int l[256];
-		for (int j = 0; ItemPrefixes[j].power.type != IPL_INVALID; j++) {
-			if (!IsPrefixValidForItemType(j, AffixItemType::Staff) || ItemPrefixes[j].PLMinLvl > lvl)
-				continue;
-			if (onlygood && !ItemPrefixes[j].PLOk)
-				continue;
-			l[nl] = j;
-			nl++;
-			if (ItemPrefixes[j].PLDouble) {
-				l[nl] = j;
-				nl++;
-			}
-		}
-		if (nl != 0) {
-			preidx = l[GenerateRnd(nl)];
+		const std::vector<uint8_t> &l = GetPrefixCandidates(AffixItemType::Staff, INT_MIN, lvl, onlygood, false);
+		if (!l.empty()) {
+			preidx = l[GenerateRnd(static_cast<int>(l.size()))];
 			item._iMagical = ITEM_QUALITY_MAGIC;
 			SaveItemAffix(player, item, ItemPrefixes[preidx]);
 			item._iPrePower = ItemPrefixes[preidx].power.type;
@@ -1146,7 +1199,6 @@ std::string GenerateMagicItemName(const string_view &baseNamel, int preidx, int
 
 void GetItemPower(const Player &player, Item &item, int minlvl, int maxlvl, AffixItemType flgs, bool onlygood)
 {
-	int l[256];
 	goodorevil goe;
 
 	bool allocatePrefix = FlipCoin(4);
@@ -1164,25 +1216,9 @@ void GetItemPower(const Player &player, Item &item, int minlvl, int maxlvl, Affi
 	if (!onlygood && !FlipCoin(3))
 		onlygood = true;
 	if (allocatePrefix) {
-		int nt = 0;
-		for (int j = 0; ItemPrefixes[j].power.type != IPL_INVALID; j++) {
-			if (!IsPrefixValidForItemType(j, flgs))
-				continue;
-			if (ItemPrefixes[j].PLMinLvl < minlvl || ItemPrefixes[j].PLMinLvl > maxlvl)
-				continue;
-			if (onlygood && !ItemPrefixes[j].PLOk)
-				continue;
-			if (HasAnyOf(flgs, AffixItemType::Staff) && ItemPrefixes[j].power.type == IPL_CHARGES)
-				continue;
-			l[nt] = j;
-			nt++;
-			if (ItemPrefixes[j].PLDouble) {
-				l[nt] = j;
-				nt++;
-			}
-		}
-		if (nt != 0) {
-			preidx = l[GenerateRnd(nt)];
+		const std::vector<uint8_t> &l = GetPrefixCandidates(flgs, minlvl, maxlvl, onlygood, HasAnyOf(flgs, AffixItemType::Staff));
+		if (!l.empty()) {
+			preidx = l[GenerateRnd(static_cast<int>(l.size()))];
 			item._iMagical = ITEM_QUALITY_MAGIC;
 			SaveItemAffix(player, item, ItemPrefixes[preidx]);
 			item._iPrePower = ItemPrefixes[preidx].power.type;
@@ -1190,18 +1226,9 @@ void GetItemPower(const Player &player, Item &item, int minlvl, int maxlvl, Affi
 		}
 	}
 	if (allocateSuffix) {
-		int nl = 0;
-		for (int j = 0; ItemSuffixes[j].power.type != IPL_INVALID; j++) {
-			if (IsSuffixValidForItemType(j, flgs)
-			    && ItemSuffixes[j].PLMinLvl >= minlvl && ItemSuffixes[j].PLMinLvl <= maxlvl
-			    && !((goe == GOE_GOOD && ItemSuffixes[j].PLGOE == GOE_EVIL) || (goe == GOE_EVIL && ItemSuffixes[j].PLGOE == GOE_GOOD))
-			    && (!onlygood || ItemSuffixes[j].PLOk)) {
-				l[nl] = j;
-				nl++;
-			}
-		}
-		if (nl != 0) {
-			sufidx = l[GenerateRnd(nl)];
+		const std::vector<uint8_t> &l = GetSuffixCandidates(flgs, minlvl, maxlvl, onlygood, goe);
+		if (!l.empty()) {
+			sufidx = l[GenerateRnd(static_cast<int>(l.size()))];
 			item._iMagical = ITEM_QUALITY_MAGIC;
 			SaveItemAffix(player, item, ItemSuffixes[sufidx]);
 			item._iSufPower = ItemSuffixes[sufidx].power.type;
@@ -1398,6 +1425,53 @@ _item_indexes RndTypeItems(ItemType itemType, int imid, int lvl)
 	});
 }
 
+/**
+ * @brief Sets `gbIsHellfire` for the guard's lifetime.
+ *
+ * Does not write it when it already has the given value, so that items can be recreated on several threads at once.
+ */
+class HellfireOverride {
+public:
+	explicit HellfireOverride(bool isHellfire)
+	    : previous_(gbIsHellfire)
+	{
+		if (isHellfire != previous_)
+			gbIsHellfire = isHellfire;
+	}
+
+	~HellfireOverride()
+	{
+		if (gbIsHellfire != previous_)
+			gbIsHellfire = previous_;
+	}
+
+	HellfireOverride(const HellfireOverride &) = delete;
+	HellfireOverride &operator=(const HellfireOverride &) = delete;
+
+private:
+	bool previous_;
+};
+
+/** @brief Returns the indices of the unique items based on the given item type, in table order. */
+const std::vector<uint8_t> &GetUniqueCandidates(unique_base_item itemType)
+{
+	static const std::vector<std::vector<uint8_t>> UniquesByType = [] {
+		std::vector<std::vector<uint8_t>> uniquesByType;
+		for (int j = 0; UniqueItems[j].UIItemId != UITYPE_INVALID; j++) {
+			const size_t type = UniqueItems[j].UIItemId;
+			if (type >= uniquesByType.size())
+				uniquesByType.resize(type + 1);
+			uniquesByType[type].push_back(j);
+		}
+		return uniquesByType;
+	}();
+	static const std::vector<uint8_t> None;
+
+	if (itemType < 0 || static_cast<size_t>(itemType) >= UniquesByType.size())
+		return None;
+	return UniquesByType[itemType];
+}
+
 _unique_items CheckUnique(Item &item, int lvl, int uper, bool recreate)
 {
 	std::bitset<128> uok = {};
@@ -1406,11 +1480,10 @@ _unique_items CheckUnique(Item &item, int lvl, int uper, bool recreate)
 		return UITEM_INVALID;
 
 	int numu = 0;
-	for (int j = 0; UniqueItems[j].UIItemId != UITYPE_INVALID; j++) {
+	for (uint8_t j : GetUniqueCandidates(AllItemsList[item.IDidx].iItemId)) {
 		if (!IsUniqueAvailable(j))
 			break;
-		if (UniqueItems[j].UIItemId == AllItemsList[item.IDidx].iItemId
-		    && lvl >= UniqueItems[j].UIMinLvl
+		if (lvl >= UniqueItems[j].UIMinLvl
 		    && (recreate || !UniqueItemFlags[j] || gbIsMultiplayer)) {
 			uok[j] = true;
 			numu++;
@@ -2326,92 +2399,231 @@ void InitItems()
 	initItemGetRecords();
 }
 
+ItemStatBonuses &ItemStatBonuses::operator+=(const ItemStatBonuses &other)
+{
+	minDamage += other.minDamage;
+	maxDamage += other.maxDamage;
+	armorClass += other.armorClass;
+	bonusDamage += other.bonusDamage;
+	bonusToHit += other.bonusToHit;
+	bonusArmorClass += other.bonusArmorClass;
+	flags |= other.flags;
+	damAcFlags |= other.damAcFlags;
+	strength += other.strength;
+	magic += other.magic;
+	dexterity += other.dexterity;
+	vitality += other.vitality;
+	spells |= other.spells;
+	fireResist += other.fireResist;
+	lightningResist += other.lightningResist;
+	magicResist += other.magicResist;
+	damageMod += other.damageMod;
+	getHit += other.getHit;
+	lightRadius += other.lightRadius;
+	hitPoints += other.hitPoints;
+	mana += other.mana;
+	spellLevels += other.spellLevels;
+	enhancedAccuracy += other.enhancedAccuracy;
+	fireMinDamage += other.fireMinDamage;
+	fireMaxDamage += other.fireMaxDamage;
+	lightningMinDamage += other.lightningMinDamage;
+	lightningMaxDamage += other.lightningMaxDamage;
+	return *this;
+}
+
+bool ItemStatBonuses::operator==(const ItemStatBonuses &other) const
+{
+	return minDamage == other.minDamage
+	    && maxDamage == other.maxDamage
+	    && armorClass == other.armorClass
+	    && bonusDamage == other.bonusDamage
+	    && bonusToHit == other.bonusToHit
+	    && bonusArmorClass == other.bonusArmorClass
+	    && flags == other.flags
+	    && damAcFlags == other.damAcFlags
+	    && strength == other.strength
+	    && magic == other.magic
+	    && dexterity == other.dexterity
+	    && vitality == other.vitality
+	    && spells == other.spells
+	    && fireResist == other.fireResist
+	    && lightningResist == other.lightningResist
+	    && magicResist == other.magicResist
+	    && damageMod == other.damageMod
+	    && getHit == other.getHit
+	    && lightRadius == other.lightRadius
+	    && hitPoints == other.hitPoints
+	    && mana == other.mana
+	    && spellLevels == other.spellLevels
+	    && enhancedAccuracy == other.enhancedAccuracy
+	    && fireMinDamage == other.fireMinDamage
+	    && fireMaxDamage == other.fireMaxDamage
+	    && lightningMinDamage == other.lightningMinDamage
+	    && lightningMaxDamage == other.lightningMaxDamage;
+}
+
+ItemStatBonuses GetItemStatBonuses(const Item &item)
+{
+	ItemStatBonuses bonuses;
+	if (item.isEmpty() || !item._iStatFlag)
+		return bonuses;
+
+	bonuses.minDamage = item._iMinDam;
+	bonuses.maxDamage = item._iMaxDam;
+	bonuses.armorClass = item._iAC;
+
+	if (IsValidSpell(item._iSpell)) {
+		bonuses.spells = GetSpellBitmask(item._iSpell);
+	}
+
+	if (item._iMagical == ITEM_QUALITY_NORMAL || item._iIdentified) {
+		bonuses.bonusDamage = item._iPLDam;
+		bonuses.bonusToHit = item._iPLToHit;
+		if (item._iPLAC != 0) {
+			int tmpac = item._iAC;
+			tmpac *= item._iPLAC;
+			tmpac /= 100;
+			if (tmpac == 0)
+				tmpac = math::Sign(item._iPLAC);
+			bonuses.bonusArmorClass = tmpac;
+		}
+		bonuses.flags = item._iFlags;
+		bonuses.damAcFlags = item._iDamAcFlags;
+		bonuses.strength = item._iPLStr;
+		bonuses.magic = item._iPLMag;
+		bonuses.dexterity = item._iPLDex;
+		bonuses.vitality = item._iPLVit;
+		bonuses.fireResist = item._iPLFR;
+		bonuses.lightningResist = item._iPLLR;
+		bonuses.magicResist = item._iPLMR;
+		bonuses.damageMod = item._iPLDamMod;
+		bonuses.getHit = item._iPLGetHit;
+		bonuses.lightRadius = item._iPLLight;
+		bonuses.hitPoints = item._iPLHP;
+		bonuses.mana = item._iPLMana;
+		bonuses.spellLevels = item._iSplLvlAdd;
+		bonuses.enhancedAccuracy = item._iPLEnAc;
+		bonuses.fireMinDamage = item._iFMinDam;
+		bonuses.fireMaxDamage = item._iFMaxDam;
+		bonuses.lightningMinDamage = item._iLMinDam;
+		bonuses.lightningMaxDamage = item._iLMaxDam;
+	}
+	return bonuses;
+}
+
+ItemStatBonusesCache::Key::Key(const Item &item)
+    : type(item._itype)
+    , statFlag(item._iStatFlag)
+    , identified(item._iIdentified)
+    , quality(item._iMagical)
+    , spell(item._iSpell)
+    , minDamage(item._iMinDam)
+    , maxDamage(item._iMaxDam)
+    , armorClass(item._iAC)
+    , flags(item._iFlags)
+    , damAcFlags(item._iDamAcFlags)
+    , bonusDamage(item._iPLDam)
+    , bonusToHit(item._iPLToHit)
+    , bonusArmorClass(item._iPLAC)
+    , strength(item._iPLStr)
+    , magic(item._iPLMag)
+    , dexterity(item._iPLDex)
+    , vitality(item._iPLVit)
+    , fireResist(item._iPLFR)
+    , lightningResist(item._iPLLR)
+    , magicResist(item._iPLMR)
+    , damageMod(item._iPLDamMod)
+    , getHit(item._iPLGetHit)
+    , lightRadius(item._iPLLight)
+    , hitPoints(item._iPLHP)
+    , mana(item._iPLMana)
+    , spellLevels(item._iSplLvlAdd)
+    , enhancedAccuracy(item._iPLEnAc)
+    , fireMinDamage(item._iFMinDam)
+    , fireMaxDamage(item._iFMaxDam)
+    , lightningMinDamage(item._iLMinDam)
+    , lightningMaxDamage(item._iLMaxDam)
+{
+}
+
+bool ItemStatBonusesCache::Key::operator==(const Key &other) const
+{
+	return type == other.type
+	    && statFlag == other.statFlag
+	    && identified == other.identified
+	    && quality == other.quality
+	    && spell == other.spell
+	    && minDamage == other.minDamage
+	    && maxDamage == other.maxDamage
+	    && armorClass == other.armorClass
+	    && flags == other.flags
+	    && damAcFlags == other.damAcFlags
+	    && bonusDamage == other.bonusDamage
+	    && bonusToHit == other.bonusToHit
+	    && bonusArmorClass == other.bonusArmorClass
+	    && strength == other.strength
+	    && magic == other.magic
+	    && dexterity == other.dexterity
+	    && vitality == other.vitality
+	    && fireResist == other.fireResist
+	    && lightningResist == other.lightningResist
+	    && magicResist == other.magicResist
+	    && damageMod == other.damageMod
+	    && getHit == other.getHit
+	    && lightRadius == other.lightRadius
+	    && hitPoints == other.hitPoints
+	    && mana == other.mana
+	    && spellLevels == other.spellLevels
+	    && enhancedAccuracy == other.enhancedAccuracy
+	    && fireMinDamage == other.fireMinDamage
+	    && fireMaxDamage == other.fireMaxDamage
+	    && lightningMinDamage == other.lightningMinDamage
+	    && lightningMaxDamage == other.lightningMaxDamage;
+}
+
+const ItemStatBonuses &ItemStatBonusesCache::get(const Item &item)
+{
+	const Key key { item };
+	if (!key_ || !(*key_ == key)) {
+		key_ = key;
+		bonuses_ = GetItemStatBonuses(item);
+	}
+	return bonuses_;
+}
+
 void CalcPlrItemVals(Player &player, bool loadgfx)
 {
-	int mind = 0; // min damage
-	int maxd = 0; // max damage
-	int tac = 0;  // accuracy
-
-	int bdam = 0;   // bonus damage
-	int btohit = 0; // bonus chance to hit
-	int bac = 0;    // bonus accuracy
-
-	ItemSpecialEffect iflgs = ItemSpecialEffect::None; // item_special_effect flags
-
-	ItemSpecialEffectHf pDamAcFlags = ItemSpecialEffectHf::None;
-
-	int sadd = 0; // added strength
-	int madd = 0; // added magic
-	int dadd = 0; // added dexterity
-	int vadd = 0; // added vitality
-
-	uint64_t spl = 0; // bitarray for all enabled/active spells
-
-	int fr = 0; // fire resistance
-	int lr = 0; // lightning resistance
-	int mr = 0; // magic resistance
-
-	int dmod = 0; // bonus damage mod?
-	int ghit = 0; // increased damage from enemies
-
-	int lrad = 10; // light radius
-
-	int ihp = 0;   // increased HP
-	int imana = 0; // increased mana
-
-	int spllvladd = 0; // increased spell level
-	int enac = 0;      // enhanced accuracy
+	ItemStatBonuses bonuses;
+	for (int slot = 0; slot < NUM_INVLOC; slot++) {
+		bonuses += player.InvBodyBonuses[slot].get(player.InvBody[slot]);
+	}
+#ifdef _DEBUG
+	// A change to an equipped item that the key does not cover leaves a stale contribution.
+	ItemStatBonuses expected;
+	for (const Item &item : player.InvBody) {
+		expected += GetItemStatBonuses(item);
+	}
+	assert(bonuses == expected);
+#endif
 
-	int fmin = 0; // minimum fire damage
-	int fmax = 0; // maximum fire damage
-	int lmin = 0; // minimum lightning damage
-	int lmax = 0; // maximum lightning damage
+	int mind = bonuses.minDamage;
+	int maxd = bonuses.maxDamage;
+	const int tac = bonuses.armorClass;
+	const ItemSpecialEffect iflgs = bonuses.flags;
 
-	for (auto &item : player.InvBody) {
-		if (!item.isEmpty() && item._iStatFlag) {
+	int sadd = bonuses.strength;
+	int madd = bonuses.magic;
+	int dadd = bonuses.dexterity;
+	int vadd = bonuses.vitality;
 
-			mind += item._iMinDam;
-			maxd += item._iMaxDam;
-			tac += item._iAC;
+	int fr = bonuses.fireResist;
+	int lr = bonuses.lightningResist;
+	int mr = bonuses.magicResist;
 
-			if (IsValidSpell(item._iSpell)) {
-				spl |= GetSpellBitmask(item._iSpell);
-			}
+	const int lrad = clamp(10 + bonuses.lightRadius, 2, 15);
 
-			if (item._iMagical == ITEM_QUALITY_NORMAL || item._iIdentified) {
-				bdam += item._iPLDam;
-				btohit += item._iPLToHit;
-				if (item._iPLAC != 0) {
-					int tmpac = item._iAC;
-					tmpac *= item._iPLAC;
-					tmpac /= 100;
-					if (tmpac == 0)
-						tmpac = math::Sign(item._iPLAC);
-					bac += tmpac;
-				}
-				iflgs |= item._iFlags;
-				pDamAcFlags |= item._iDamAcFlags;
-				sadd += item._iPLStr;
-				madd += item._iPLMag;
-				dadd += item._iPLDex;
-				vadd += item._iPLVit;
-				fr += item._iPLFR;
-				lr += item._iPLLR;
-				mr += item._iPLMR;
-				dmod += item._iPLDamMod;
-				ghit += item._iPLGetHit;
-				lrad += item._iPLLight;
-				ihp += item._iPLHP;
-				imana += item._iPLMana;
-				spllvladd += item._iSplLvlAdd;
-				enac += item._iPLEnAc;
-				fmin += item._iFMinDam;
-				fmax += item._iFMaxDam;
-				lmin += item._iLMinDam;
-				lmax += item._iLMaxDam;
-			}
-		}
-	}
+	int ihp = bonuses.hitPoints;
+	int imana = bonuses.mana;
 
 	if (mind == 0 && maxd == 0) {
 		mind = 1;
@@ -2445,15 +2657,13 @@ void CalcPlrItemVals(Player &player, bool loadgfx)
 	player._pIMinDam = mind;
 	player._pIMaxDam = maxd;
 	player._pIAC = tac;
-	player._pIBonusDam = bdam;
-	player._pIBonusToHit = btohit;
-	player._pIBonusAC = bac;
+	player._pIBonusDam = bonuses.bonusDamage;
+	player._pIBonusToHit = bonuses.bonusToHit;
+	player._pIBonusAC = bonuses.bonusArmorClass;
 	player._pIFlags = iflgs;
-	player.pDamAcFlags = pDamAcFlags;
-	player._pIBonusDamMod = dmod;
-	player._pIGetHit = ghit;
-
-	lrad = clamp(lrad, 2, 15);
+	player.pDamAcFlags = bonuses.damAcFlags;
+	player._pIBonusDamMod = bonuses.damageMod;
+	player._pIGetHit = bonuses.getHit;
 
 	if (player._pLightRad != lrad) {
 		ChangeLightRadius(player._plid, lrad);
@@ -2505,12 +2715,12 @@ void CalcPlrItemVals(Player &player, bool loadgfx)
 		player._pDamageMod = player._pLevel * player._pStrength / 100;
 	}
 
-	player._pISpells = spl;
+	player._pISpells = bonuses.spells;
 
 	EnsureValidReadiedSpell(player);
 
-	player._pISplLvlAdd = spllvladd;
-	player._pIEnAc = enac;
+	player._pISplLvlAdd = bonuses.spellLevels;
+	player._pIEnAc = bonuses.enhancedAccuracy;
 
 	if (player._pClass == HeroClass::Barbarian) {
 		mr += player._pLevel;
@@ -2551,10 +2761,10 @@ void CalcPlrItemVals(Player &player, bool loadgfx)
 	player._pMaxMana = imana + player._pMaxManaBase;
 	player._pMana = std::min(imana + player._pManaBase, player._pMaxMana);
 
-	player._pIFMinDam = fmin;
-	player._pIFMaxDam = fmax;
-	player._pILMinDam = lmin;
-	player._pILMaxDam = lmax;
+	player._pIFMinDam = bonuses.fireMinDamage;
+	player._pIFMaxDam = bonuses.fireMaxDamage;
+	player._pILMinDam = bonuses.lightningMinDamage;
+	player._pILMaxDam = bonuses.lightningMaxDamage;
 
 	player._pInfraFlag = false;
 
@@ -3107,8 +3317,7 @@ void CreateTypeItem(Point position, bool onlygood, ItemType itemType, int imisc,
 
 void RecreateItem(const Player &player, Item &item, _item_indexes idx, uint16_t icreateinfo, int iseed, int ivalue, bool isHellfire)
 {
-	bool tmpIsHellfire = gbIsHellfire;
-	gbIsHellfire = isHellfire;
+	const HellfireOverride hellfireOverride(isHellfire);
 
 	if (idx == IDI_GOLD) {
 		InitializeItem(item, IDI_GOLD);
@@ -3116,27 +3325,23 @@ void RecreateItem(const Player &player, Item &item, _item_indexes idx, uint16_t
 		item._iCreateInfo = icreateinfo;
 		item._ivalue = ivalue;
 		SetPlrHandGoldCurs(item);
-		gbIsHellfire = tmpIsHellfire;
 		return;
 	}
 
 	if (icreateinfo == 0) {
 		InitializeItem(item, idx);
 		item._iSeed = iseed;
-		gbIsHellfire = tmpIsHellfire;
 		return;
 	}
 
 	if ((icreateinfo & CF_UNIQUE) == 0) {
 		if ((icreateinfo & CF_TOWN) != 0) {
 			RecreateTownItem(player, item, idx, icreateinfo, iseed);
-			gbIsHellfire = tmpIsHellfire;
 			return;
 		}
 
 		if ((icreateinfo & CF_USEFUL) == CF_USEFUL) {
 			SetupAllUseful(item, iseed, icreateinfo & CF_LEVEL);
-			gbIsHellfire = tmpIsHellfire;
 			return;
 		}
 	}
@@ -3154,7 +3359,6 @@ void RecreateItem(const Player &player, Item &item, _item_indexes idx, uint16_t
 	bool pregen = (icreateinfo & CF_PREGEN) != 0;
 
 	SetupAllItems(player, item, idx, iseed, level, uper, onlygood, recreate, pregen);
-	gbIsHellfire = tmpIsHellfire;
 }
 
 void RecreateEar(Item &item, uint16_t ic, int iseed, uint8_t bCursval, string_view heroName)
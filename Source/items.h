@@ -453,6 +453,101 @@ struct Item {
 	void updateRequiredStatsCacheForPlayer(const Player &player);
 };
 
+/**
+ * @brief Bonuses that an equipped item adds to the stats of the player wearing it.
+ */
+struct ItemStatBonuses {
+	int minDamage = 0;
+	int maxDamage = 0;
+	int armorClass = 0;
+	int bonusDamage = 0;
+	int bonusToHit = 0;
+	int bonusArmorClass = 0;
+	ItemSpecialEffect flags = ItemSpecialEffect::None;
+	ItemSpecialEffectHf damAcFlags = ItemSpecialEffectHf::None;
+	int strength = 0;
+	int magic = 0;
+	int dexterity = 0;
+	int vitality = 0;
+	/** @brief Bitmask of the spells granted by the item. */
+	uint64_t spells = 0;
+	int fireResist = 0;
+	int lightningResist = 0;
+	int magicResist = 0;
+	int damageMod = 0;
+	int getHit = 0;
+	int lightRadius = 0;
+	int hitPoints = 0;
+	int mana = 0;
+	int spellLevels = 0;
+	int enhancedAccuracy = 0;
+	int fireMinDamage = 0;
+	int fireMaxDamage = 0;
+	int lightningMinDamage = 0;
+	int lightningMaxDamage = 0;
+
+	ItemStatBonuses &operator+=(const ItemStatBonuses &other);
+	bool operator==(const ItemStatBonuses &other) const;
+};
+
+/**
+ * @brief Keeps the bonuses of the item equipped in a body slot, so that they are only computed again when it changes.
+ */
+class ItemStatBonusesCache {
+public:
+	/**
+	 * @brief Returns the same as `GetItemStatBonuses(item)`.
+	 */
+	const ItemStatBonuses &get(const Item &item);
+
+private:
+	/**
+	 * @brief The fields of an item that `GetItemStatBonuses` reads.
+	 *
+	 * All of them are part of the key, as most change in place while the item is equipped: by identifying it, by
+	 * oils, shrines and weapon decay, by the wearer's stats and by loading a game into the same player.
+	 */
+	struct Key {
+		ItemType type;
+		bool statFlag;
+		bool identified;
+		item_quality quality;
+		SpellID spell;
+		uint8_t minDamage;
+		uint8_t maxDamage;
+		int16_t armorClass;
+		ItemSpecialEffect flags;
+		ItemSpecialEffectHf damAcFlags;
+		int16_t bonusDamage;
+		int16_t bonusToHit;
+		int16_t bonusArmorClass;
+		int16_t strength;
+		int16_t magic;
+		int16_t dexterity;
+		int16_t vitality;
+		int16_t fireResist;
+		int16_t lightningResist;
+		int16_t magicResist;
+		int16_t damageMod;
+		int16_t getHit;
+		int16_t lightRadius;
+		int16_t hitPoints;
+		int16_t mana;
+		int8_t spellLevels;
+		int16_t enhancedAccuracy;
+		int16_t fireMinDamage;
+		int16_t fireMaxDamage;
+		int16_t lightningMinDamage;
+		int16_t lightningMaxDamage;
+
+		explicit Key(const Item &item);
+		bool operator==(const Key &other) const;
+	};
+
+	std::optional<Key> key_;
+	ItemStatBonuses bonuses_;
+};
+
 struct ItemGetRecordStruct {
 	int32_t nSeed;
 	uint16_t wCI;
@@ -475,13 +570,18 @@ extern uint8_t ActiveItemCount;
 extern int8_t dItem[MAXDUNX][MAXDUNY];
 extern bool ShowUniqueItemInfoBox;
 extern CornerStoneStruct CornerStone;
-extern bool UniqueItemFlags[128];
+/** @brief Which uniques have dropped in this game, per thread like the RNG state so that tools can recreate items on several threads. */
+extern thread_local bool UniqueItemFlags[128];
 
 uint8_t GetOutlineColor(const Item &item, bool checkReq);
 bool IsItemAvailable(int i);
 bool IsUniqueAvailable(int i);
 void InitItemGFX();
 void InitItems();
+/**
+ * @brief Returns the bonuses of an equipped item, nothing if the item is empty or its requirements are not met.
+ */
+ItemStatBonuses GetItemStatBonuses(const Item &item);
 void CalcPlrItemVals(Player &player, bool Loadgfx);
 void CalcPlrInv(Player &player, bool Loadgfx);
 void InitializeItem(Item &item, _item_indexes itemData);
@@ -2,6 +2,7 @@
 
 #include "levels/gendung.h"
 
+#include "engine/level_prefetch.hpp"
 #include "engine/load_file.hpp"
 #include "engine/random.hpp"
 #include "init.h"
@@ -55,26 +56,7 @@ namespace {
 
 std::unique_ptr<uint16_t[]> LoadMinData(size_t &tileCount)
 {
-	switch (leveltype) {
-	case DTYPE_TOWN:
-		if (gbIsHellfire)
-			return LoadFileInMem<uint16_t>("nlevels\\towndata\\town.min", &tileCount);
-		return LoadFileInMem<uint16_t>("levels\\towndata\\town.min", &tileCount);
-	case DTYPE_CATHEDRAL:
-		return LoadFileInMem<uint16_t>("levels\\l1data\\l1.min", &tileCount);
-	case DTYPE_CATACOMBS:
-		return LoadFileInMem<uint16_t>("levels\\l2data\\l2.min", &tileCount);
-	case DTYPE_CAVES:
-		return LoadFileInMem<uint16_t>("levels\\l3data\\l3.min", &tileCount);
-	case DTYPE_HELL:
-		return LoadFileInMem<uint16_t>("levels\\l4data\\l4.min", &tileCount);
-	case DTYPE_NEST:
-		return LoadFileInMem<uint16_t>("nlevels\\l6data\\l6.min", &tileCount);
-	case DTYPE_CRYPT:
-		return LoadFileInMem<uint16_t>("nlevels\\l5data\\l5.min", &tileCount);
-	default:
-		app_fatal("LoadMinData");
-	}
+	return LoadPrefetchedFileInMem<uint16_t>(GetTilesetPaths(leveltype).min, &tileCount);
 }
 
 /**
@@ -411,17 +393,36 @@ bool TileHasAny(int tileId, TileProperties property)
 	return HasAnyOf(SOLData[tileId], property);
 }
 
-void LoadLevelSOLData()
+TilesetPaths GetTilesetPaths(dungeon_type type)
 {
-	switch (leveltype) {
+	switch (type) {
 	case DTYPE_TOWN:
 		if (gbIsHellfire)
-			LoadFileInMem("nlevels\\towndata\\town.sol", SOLData);
-		else
-			LoadFileInMem("levels\\towndata\\town.sol", SOLData);
-		break;
+			return { "nlevels\\towndata\\town.cel", "nlevels\\towndata\\town.til", "nlevels\\towndata\\town.min", "nlevels\\towndata\\town.sol", "levels\\towndata\\towns" };
+		return { "levels\\towndata\\town.cel", "levels\\towndata\\town.til", "levels\\towndata\\town.min", "levels\\towndata\\town.sol", "levels\\towndata\\towns" };
+	case DTYPE_CATHEDRAL:
+		return { "levels\\l1data\\l1.cel", "levels\\l1data\\l1.til", "levels\\l1data\\l1.min", "levels\\l1data\\l1.sol", "levels\\l1data\\l1s" };
+	case DTYPE_CATACOMBS:
+		return { "levels\\l2data\\l2.cel", "levels\\l2data\\l2.til", "levels\\l2data\\l2.min", "levels\\l2data\\l2.sol", "levels\\l2data\\l2s" };
+	case DTYPE_CAVES:
+		return { "levels\\l3data\\l3.cel", "levels\\l3data\\l3.til", "levels\\l3data\\l3.min", "levels\\l3data\\l3.sol", "levels\\l1data\\l1s" };
+	case DTYPE_HELL:
+		return { "levels\\l4data\\l4.cel", "levels\\l4data\\l4.til", "levels\\l4data\\l4.min", "levels\\l4data\\l4.sol", "levels\\l2data\\l2s" };
+	case DTYPE_NEST:
+		return { "nlevels\\l6data\\l6.cel", "nlevels\\l6data\\l6.til", "nlevels\\l6data\\l6.min", "nlevels\\l6data\\l6.sol", "levels\\l1data\\l1s" };
+	case DTYPE_CRYPT:
+		return { "nlevels\\l5data\\l5.cel", "nlevels\\l5data\\l5.til", "nlevels\\l5data\\l5.min", "nlevels\\l5data\\l5.sol", "nlevels\\l5data\\l5s" };
+	default:
+		app_fatal("GetTilesetPaths");
+	}
+}
+
+void LoadLevelSOLData()
+{
+	LoadPrefetchedFileInMem(GetTilesetPaths(leveltype).sol, SOLData);
+
+	switch (leveltype) {
 	case DTYPE_CATHEDRAL:
-		LoadFileInMem("levels\\l1data\\l1.sol", SOLData);
 		// Fix incorrectly marked arched tiles
 		SOLData[9] |= TileProperties::BlockLight | TileProperties::BlockMissile;
 		SOLData[15] |= TileProperties::BlockLight | TileProperties::BlockMissile;
@@ -448,24 +449,11 @@ void LoadLevelSOLData()
 		// Fix incorrectly marked wall tile
 		SOLData[450] |= TileProperties::BlockLight | TileProperties::BlockMissile;
 		break;
-	case DTYPE_CATACOMBS:
-		LoadFileInMem("levels\\l2data\\l2.sol", SOLData);
-		break;
-	case DTYPE_CAVES:
-		LoadFileInMem("levels\\l3data\\l3.sol", SOLData);
-		break;
 	case DTYPE_HELL:
-		LoadFileInMem("levels\\l4data\\l4.sol", SOLData);
 		SOLData[210] = TileProperties::None; // Tile is incorrectly marked as being solid
 		break;
-	case DTYPE_NEST:
-		LoadFileInMem("nlevels\\l6data\\l6.sol", SOLData);
-		break;
-	case DTYPE_CRYPT:
-		LoadFileInMem("nlevels\\l5data\\l5.sol", SOLData);
-		break;
 	default:
-		app_fatal("LoadLevelSOLData");
+		break;
 	}
 }
 
@@ -137,6 +137,19 @@ struct MICROS {
 	uint16_t mt[16];
 };
 
+/** @brief The files that make up the tileset of a dungeon type. */
+struct TilesetPaths {
+	const char *cel;
+	const char *til;
+	const char *min;
+	const char *sol;
+	/** @brief Sprites drawn on top of some tiles, without the file extension as passed to `LoadCel`. */
+	const char *specialCel;
+};
+
+/** @brief Frame width of the sprites in `TilesetPaths::specialCel`. */
+constexpr uint16_t SpecialCelWidth = 64;
+
 struct ShadowStruct {
 	uint8_t strig;
 	uint8_t s1;
@@ -330,6 +343,7 @@ struct Miniset {
 };
 
 bool TileHasAny(int tileId, TileProperties property);
+TilesetPaths GetTilesetPaths(dungeon_type type);
 void LoadLevelSOLData();
 void SetDungeonMicros();
 void DRLG_InitTrans();
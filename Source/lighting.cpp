@@ -11,6 +11,7 @@
 #include "automap.h"
 #include "diablo.h"
 #include "engine/load_file.hpp"
+#include "engine/render/dun_render.hpp"
 #include "player.h"
 #include <engine/palette.cpp>
 
@@ -402,6 +403,8 @@ void MakeLightTable()
 		std::fill_n(LightTables[15].begin() + 1, 15, 1);
 	}
 
+	ClearTileLightCache();
+
 	LoadFileInMem("plrgfx\\infra.trn", InfravisionTable);
 	LoadFileInMem("plrgfx\\stone.trn", StoneTable);
 	LoadFileInMem("gendata\\pause.trn", PauseTable);
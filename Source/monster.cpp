@@ -91,6 +91,27 @@ constexpr const std::array<_monster_id, 12> SkeletonTypes {
 /** Maps from monster action to monster animation letter. */
 constexpr char Animletter[7] = "nwahds";
 
+/**
+ * @brief Active monsters with `MFLAG_GOLEM` in `ActiveMonsters` order, the only monsters other monsters can target.
+ *
+ * Collected at the start of `ProcessMonsters`. No monster becomes a golem and `ActiveMonsters` is only appended to
+ * until the end of `ProcessMonsters`, so the list stays complete until then.
+ */
+std::array<int, MaxMonsters> GolemMonsters;
+size_t GolemMonsterCount;
+bool GolemMonstersValid = false;
+
+void CollectGolemMonsters()
+{
+	GolemMonsterCount = 0;
+	for (size_t i = 0; i < ActiveMonsterCount; i++) {
+		const int monsterId = ActiveMonsters[i];
+		if ((Monsters[monsterId].flags & MFLAG_GOLEM) != 0)
+			GolemMonsters[GolemMonsterCount++] = monsterId;
+	}
+	GolemMonstersValid = true;
+}
+
 size_t GetNumAnims(const MonsterData &monsterData)
 {
 	return monsterData.hasSpecial ? 6 : 5;
@@ -635,8 +656,12 @@ void UpdateEnemy(Monster &monster)
 			}
 		}
 	}
-	for (size_t i = 0; i < ActiveMonsterCount; i++) {
-		const int monsterId = ActiveMonsters[i];
+	// Monsters that are neither golems nor berserk only target golems
+	const bool targetsGolemsOnly = (monster.flags & (MFLAG_GOLEM | MFLAG_BERSERK)) == 0;
+	const bool useGolemList = targetsGolemsOnly && GolemMonstersValid;
+	const size_t candidateCount = useGolemList ? GolemMonsterCount : ActiveMonsterCount;
+	for (size_t i = 0; i < candidateCount; i++) {
+		const int monsterId = useGolemList ? GolemMonsters[i] : ActiveMonsters[i];
 		Monster &otherMonster = Monsters[monsterId];
 		if (&otherMonster == &monster)
 			continue;
@@ -3950,6 +3975,7 @@ void ProcessMonsters()
 	DeleteMonsterList();
 
 	assert(ActiveMonsterCount <= MaxMonsters);
+	CollectGolemMonsters();
 	for (size_t i = 0; i < ActiveMonsterCount; i++) {
 		Monster &monster = Monsters[ActiveMonsters[i]];
 		FollowTheLeader(monster);
@@ -4016,6 +4042,7 @@ void ProcessMonsters()
 		}
 	}
 
+	GolemMonstersValid = false;
 	DeleteMonsterList();
 }
 
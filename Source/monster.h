@@ -198,24 +198,30 @@ struct CMonster {
 extern CMonster LevelMonsterTypes[MaxLvlMTypes];
 
 struct Monster { // note: missing field _mAFNum
-	std::unique_ptr<uint8_t[]> uniqueMonsterTRN;
-	/**
-	 * @brief Contains information for current animation
-	 */
-	AnimationInfo animInfo;
-	int maxHitPoints;
+	// Fields used by every monster on every game tick come first, so that they share as few cache lines as possible.
 	int hitPoints;
 	uint32_t flags;
-	/** Seed used to determine item drops on death */
-	uint32_t rndItemSeed;
 	/** Seed used to determine AI behaviour/sync sounds in multiplayer games? */
 	uint32_t aiSeed;
-	uint16_t toHit;
-	uint16_t resistance;
+	ActorPosition position;
+	/** Usually corresponds to the enemy's future position */
+	WorldTilePosition enemyPosition;
+	MonsterMode mode;
+	/** The current target of the monster. An index in to either the player or monster array based on the _meflag value. */
+	uint8_t enemy;
+	/** Stores information for how many ticks the monster will remain active */
+	uint8_t activeForTicks;
+	/** Direction faced by monster (direction enum) */
+	Direction direction;
+	MonsterAIID ai;
+	uint8_t levelType;
+	bool isInvalid;
+	int8_t lightId;
 	_speech_id talkMsg;
+	int maxHitPoints;
 
-	/** @brief Specifies monster's behaviour regarding moving and changing goals. */
-	int16_t goalVar1;
+	/** Specifies current goal of the monster */
+	MonsterGoal goal;
 
 	/**
 	 * @brief Specifies turning direction for @p RoundWalk in most cases.
@@ -223,53 +229,49 @@ struct Monster { // note: missing field _mAFNum
 	 */
 	int8_t goalVar2;
 
+	/** @brief Specifies monster's behaviour regarding moving and changing goals. */
+	int16_t goalVar1;
+
 	/**
 	 * @brief Controls monster's behaviour regarding special actions.
 	 * Used only by @p ScavengerAi and @p MegaAi.
 	 */
 	int8_t goalVar3;
 
+	int8_t var3;
 	int16_t var1;
 	int16_t var2;
-	int8_t var3;
-
-	ActorPosition position;
-
-	/** Specifies current goal of the monster */
-	MonsterGoal goal;
-
-	/** Usually corresponds to the enemy's future position */
-	WorldTilePosition enemyPosition;
-	uint8_t levelType;
-	MonsterMode mode;
 	uint8_t pathCount;
-	/** Direction faced by monster (direction enum) */
-	Direction direction;
-	/** The current target of the monster. An index in to either the player or monster array based on the _meflag value. */
-	uint8_t enemy;
-	bool isInvalid;
-	MonsterAIID ai;
 	/**
 	 * @brief Specifies monster's behaviour across various actions.
 	 * Generally, when monster thinks it decides what to do based on this value, among other things.
 	 * Higher values should result in more aggressive behaviour (e.g. some monsters use this to calculate the @p AiDelay).
 	 */
 	uint8_t intelligence;
-	/** Stores information for how many ticks the monster will remain active */
-	uint8_t activeForTicks;
+	uint8_t leader;
+	LeaderRelation leaderRelation;
+	uint8_t packSize;
+	int8_t whoHit;
+
+	/**
+	 * @brief Contains information for current animation
+	 */
+	AnimationInfo animInfo;
+
+	// Fields only used when the monster fights, dies or is drawn.
+	std::unique_ptr<uint8_t[]> uniqueMonsterTRN;
+	/** Seed used to determine item drops on death */
+	uint32_t rndItemSeed;
+	uint16_t toHit;
+	uint16_t resistance;
 	UniqueMonsterType uniqueType;
 	uint8_t uniqTrans;
 	int8_t corpseId;
-	int8_t whoHit;
 	uint8_t minDamage;
 	uint8_t maxDamage;
 	uint8_t minDamageSpecial;
 	uint8_t maxDamageSpecial;
 	uint8_t armorClass;
-	uint8_t leader;
-	LeaderRelation leaderRelation;
-	uint8_t packSize;
-	int8_t lightId;
 
 	static constexpr uint8_t NoLeader = -1;
 
@@ -61,6 +61,11 @@ public:
 
 	bool HasFile(const char *filename) const;
 
+	[[nodiscard]] const std::string &path() const
+	{
+		return path_;
+	}
+
 private:
 	MpqArchive(std::string path, mpq_archive_s *archive)
 	    : path_(std::move(path))
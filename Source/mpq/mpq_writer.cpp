@@ -1,11 +1,14 @@
 #include "mpq/mpq_writer.hpp"
 
+#include <algorithm>
 #include <cstddef>
 #include <cstdint>
 #include <cstring>
 #include <memory>
 #include <type_traits>
 
+#include <SDL.h>
+
 #include "appfat.h"
 #include "encrypt.h"
 #include "engine.h"
@@ -14,6 +17,7 @@
 #include "utils/language.h"
 #include "utils/log.hpp"
 #include "utils/str_cat.hpp"
+#include "utils/worker_pool.hpp"
 
 namespace devilution {
 
@@ -83,6 +87,24 @@ bool IsUnallocatedBlock(const MpqBlockEntry *block)
 	return block->offset == 0 && block->packedSize == 0 && block->unpackedSize == 0 && block->flags == 0;
 }
 
+// Upper bound for the threads that help compress the sectors of a file.
+constexpr unsigned MaxCompressionWorkers = 3;
+
+/**
+ * @brief Returns the threads that help compress sectors, created on first use.
+ *
+ * Saving only happens on the main thread, so the pool is never asked to run two jobs at once.
+ */
+WorkerPool &GetCompressionWorkers()
+{
+#ifdef USE_SDL1
+	static WorkerPool workers { 0 };
+#else
+	static WorkerPool workers { std::min(static_cast<unsigned>(std::max(SDL_GetCPUCount() - 1, 0)), MaxCompressionWorkers) };
+#endif
+	return workers;
+}
+
 } // namespace
 
 MpqWriter::MpqWriter(const char *path)
@@ -407,22 +429,27 @@ bool MpqWriter::WriteFileContents(const char *filename, const byte *fileData, si
 	}
 #endif
 
+	// Each sector is compressed independently, so they can be compressed in parallel and then written in order.
+	std::unique_ptr<byte[]> sectorData { new byte[static_cast<size_t>(numSectors) * BlockSize] };
+	std::unique_ptr<uint32_t[]> sectorSizes { new uint32_t[numSectors] };
+	const auto compressSector = [&](unsigned sector) {
+		const size_t offset = static_cast<size_t>(sector) * BlockSize;
+		const uint32_t len = static_cast<uint32_t>(std::min<size_t>(fileSize - offset, BlockSize));
+		sectorSizes[sector] = PkwareCompress(&fileData[offset], len, &sectorData[offset]);
+	};
+	if (numSectors > 1) {
+		GetCompressionWorkers().parallelFor(numSectors, compressSector);
+	} else if (numSectors == 1) {
+		compressSector(0);
+	}
+
 	uint32_t destSize = offsetTableByteSize;
-	byte mpqBuf[BlockSize];
-	size_t curSector = 0;
-	while (true) {
-		uint32_t len = std::min<uint32_t>(fileSize, BlockSize);
-		memcpy(mpqBuf, fileData, len);
-		fileData += len;
-		len = PkwareCompress(mpqBuf, len);
-		if (!stream_.Write(reinterpret_cast<const char *>(&mpqBuf[0]), len))
+	for (uint32_t sector = 0; sector < numSectors; sector++) {
+		const uint32_t len = sectorSizes[sector];
+		if (!stream_.Write(reinterpret_cast<const char *>(&sectorData[static_cast<size_t>(sector) * BlockSize]), len))
 			return false;
-		offsetTable[curSector++] = SDL_SwapLE32(destSize);
+		offsetTable[sector] = SDL_SwapLE32(destSize);
 		destSize += len; // compressed length
-		if (fileSize <= BlockSize)
-			break;
-
-		fileSize -= BlockSize;
 	}
 
 	offsetTable[numSectors] = SDL_SwapLE32(destSize);
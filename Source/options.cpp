@@ -992,8 +992,12 @@ GraphicsOptions::GraphicsOptions()
     , hardwareCursorMaxSize("Hardware Cursor Maximum Size", OptionEntryFlags::CantChangeInGame | OptionEntryFlags::RecreateUI | (HardwareCursorSupported() ? OptionEntryFlags::None : OptionEntryFlags::Invisible), N_("Hardware Cursor Maximum Size"), N_("Maximum width / height for the hardware cursor. Larger cursors fall back to software."), 128, { 0, 64, 128, 256, 512 })
 #endif
     , limitFPS("FPS Limiter", OptionEntryFlags::None, N_("FPS Limiter"), N_("FPS is limited to avoid high CPU load. Limit considers refresh rate."), true)
+    , lowLatencyPacing("Low Latency Pacing", OptionEntryFlags::None, N_("Low Latency Pacing"), N_("The FPS Limiter waits before reading input for a frame rather than after showing it, which reduces input lag. Has no effect with Vertical Sync."), false)
     , showItemGraphicsInStores("Show Item Graphics in Stores", OptionEntryFlags::None, N_("Show Item Graphics in Stores"), N_("Show item graphics to the left of item descriptions in store menus."), false)
     , showFPS("Show FPS", OptionEntryFlags::None, N_("Show FPS"), N_("Displays the FPS in the upper left corner of the screen."), false)
+    , renderThreads("Render Threads", OptionEntryFlags::None, N_("Render Threads"), N_("Number of threads used to draw the game view. More threads can improve the frame rate on multi-core devices."), 1, { 1, 2, 3, 4, 6, 8 })
+    , pipelinedRendering("Pipelined Rendering", OptionEntryFlags::None, N_("Pipelined Rendering"), N_("Draws the game view on a separate thread while the next game tick is processed. Uses an additional core, but shows the game view one frame later."), false)
+    , spriteCache("Sprite Cache", OptionEntryFlags::None, N_("Sprite Cache"), N_("Keeps converted sprites in the save folder so that later loads skip decompressing and converting them."), false)
     , showHealthValues("Show health values", OptionEntryFlags::None, N_("Show health values"), N_("Displays current / max health value on health globe."), false)
     , showManaValues("Show mana values", OptionEntryFlags::None, N_("Show mana values"), N_("Displays current / max mana value on mana globe."), false)
 {
@@ -1030,7 +1034,11 @@ std::vector<OptionEntryBase *> GraphicsOptions::GetEntries()
 		&gammaCorrection,
 		&zoom,
 		&limitFPS,
+		&lowLatencyPacing,
 		&showFPS,
+		&renderThreads,
+		&pipelinedRendering,
+		&spriteCache,
 		&showItemGraphicsInStores,
 		&showHealthValues,
 		&showManaValues,
@@ -514,10 +514,18 @@ struct GraphicsOptions : OptionCategoryBase {
 #endif
 	/** @brief Enable FPS Limiter. */
 	OptionEntryBoolean limitFPS;
+	/** @brief Have the FPS Limiter wait before a frame rather than after it. */
+	OptionEntryBoolean lowLatencyPacing;
 	/** @brief Show item graphics to the left of item descriptions in store menus. */
 	OptionEntryBoolean showItemGraphicsInStores;
 	/** @brief Show FPS, even without the -f command line flag. */
 	OptionEntryBoolean showFPS;
+	/** @brief Number of threads that render the game view, each one renders a horizontal band. */
+	OptionEntryInt<int> renderThreads;
+	/** @brief Draw the game view on a separate thread while the next game tick is processed. */
+	OptionEntryBoolean pipelinedRendering;
+	/** @brief Keep converted sprites on disk so that later loads skip decompressing and converting them. */
+	OptionEntryBoolean spriteCache;
 	/** @brief Display current/max health values on health globe. */
 	OptionEntryBoolean showHealthValues;
 	/** @brief Display current/max mana values on mana globe. */
@@ -5,6 +5,8 @@
  */
 #include "pfile.h"
 
+#include <array>
+#include <cstdio>
 #include <string>
 #include <unordered_map>
 
@@ -23,6 +25,7 @@
 #include "utils/endian.hpp"
 #include "utils/file_util.h"
 #include "utils/language.h"
+#include "utils/log.hpp"
 #include "utils/paths.h"
 #include "utils/stdcompat/abs.hpp"
 #include "utils/stdcompat/string_view.hpp"
@@ -149,8 +152,194 @@ void EncodeHero(SaveWriter &saveWriter, const PlayerPack *pack)
 	saveWriter.WriteFile("hero", packed.get(), packedLen);
 }
 
+/** Identifies the hero roster index file ("DXHI"). */
+constexpr uint32_t HeroIndexMagic = 0x49485844;
+constexpr uint32_t HeroIndexVersion = 1;
+constexpr size_t HeroIndexHeaderSize = 12;
+constexpr size_t HeroIndexEntrySize = 48 + PlayerNameLength;
+
+enum HeroIndexFlags : uint8_t {
+	// clang-format off
+	HeroIndexValid    = 1 << 0,
+	HeroIndexExists   = 1 << 1,
+	HeroIndexListed   = 1 << 2,
+	HeroIndexHasSaved = 1 << 3,
+	HeroIndexHellfire = 1 << 4,
+	// clang-format on
+};
+
+/**
+ * @brief Character selection data of one save slot, as cached in the hero roster index.
+ *
+ * The entry is only trusted while the save file still has the recorded size and modification time.
+ */
+struct HeroIndexEntry {
+	uint8_t flags;
+	uint64_t fileSize;
+	int64_t fileTime;
+	/** Name as stored in the save, used for the list of taken slots. */
+	char name[PlayerNameLength];
+	_uiheroinfo info;
+};
+
+using HeroIndex = std::array<HeroIndexEntry, MAX_CHARACTERS>;
+
+std::string GetHeroIndexPath()
+{
+	return StrCat(paths::PrefPath(),
+	    gbIsSpawn
+	        ? (gbIsMultiplayer ? "share_" : "spawn_")
+	        : (gbIsMultiplayer ? "multi_" : "single_"),
+	    "heroes.idx");
+}
+
+/**
+ * @brief Stats the save file of the given slot.
+ * @return The entry flags describing the save (HeroIndexExists or 0), with the stamp written to the entry.
+ */
+uint8_t StatSaveFile(uint32_t saveNum, HeroIndexEntry &entry)
+{
+	entry.fileSize = 0;
+	entry.fileTime = 0;
+#ifdef UNPACKED_SAVES
+	const std::string path = GetSavePath(saveNum) + "hero";
+#else
+	const std::string path = GetSavePath(saveNum);
+#endif
+	uintmax_t size;
+	int64_t time;
+	if (!GetFileSize(path.c_str(), &size) || !GetFileModificationTime(path.c_str(), &time))
+		return 0;
+	entry.fileSize = size;
+	entry.fileTime = time;
+	return HeroIndexExists;
+}
+
+void WriteLE64(byte *out, uint64_t val)
+{
+	WriteLE32(out, static_cast<uint32_t>(val));
+	WriteLE32(out + 4, static_cast<uint32_t>(val >> 32));
+}
+
+uint64_t LoadLE64(const byte *b)
+{
+	return LoadLE32(b) | static_cast<uint64_t>(LoadLE32(b + 4)) << 32;
+}
+
+/**
+ * @brief Reads the hero roster index of the current game mode.
+ *
+ * Entries of a missing, truncated or outdated index are left invalid.
+ */
+void ReadHeroIndex(HeroIndex &index)
+{
+	for (HeroIndexEntry &entry : index)
+		entry.flags = 0;
+
+	const std::string path = GetHeroIndexPath();
+	uintmax_t size;
+	if (!GetFileSize(path.c_str(), &size) || size != HeroIndexHeaderSize + HeroIndexEntrySize * MAX_CHARACTERS)
+		return;
+	FILE *file = OpenFile(path.c_str(), "rb");
+	if (file == nullptr)
+		return;
+	std::unique_ptr<byte[]> data { new byte[size] };
+	const bool ok = std::fread(data.get(), size, 1, file) == 1;
+	std::fclose(file);
+	if (!ok)
+		return;
+
+	const byte *src = data.get();
+	if (LoadLE32(src) != HeroIndexMagic || LoadLE32(src + 4) != HeroIndexVersion || LoadLE32(src + 8) != MAX_CHARACTERS)
+		return;
+	src += HeroIndexHeaderSize;
+
+	for (uint32_t i = 0; i < MAX_CHARACTERS; i++, src += HeroIndexEntrySize) {
+		HeroIndexEntry &entry = index[i];
+		entry.fileSize = LoadLE64(src);
+		entry.fileTime = static_cast<int64_t>(LoadLE64(src + 8));
+		_uiheroinfo &info = entry.info;
+		info = {};
+		info.saveNumber = i;
+		info.level = static_cast<uint8_t>(src[17]);
+		info.heroclass = static_cast<HeroClass>(src[18]);
+		info.herorank = static_cast<uint8_t>(src[19]);
+		info.strength = LoadLE16(src + 20);
+		info.magic = LoadLE16(src + 22);
+		info.dexterity = LoadLE16(src + 24);
+		info.vitality = LoadLE16(src + 26);
+		memcpy(info.name, src + 28, sizeof(info.name));
+		info.name[sizeof(info.name) - 1] = '\0';
+		memcpy(entry.name, src + 48, sizeof(entry.name));
+		entry.name[sizeof(entry.name) - 1] = '\0';
+		info.hassaved = (static_cast<uint8_t>(src[16]) & HeroIndexHasSaved) != 0;
+		info.spawned = gbIsSpawn;
+		if (info.heroclass > HeroClass::LAST)
+			continue;
+		entry.flags = static_cast<uint8_t>(src[16]);
+	}
+}
+
+void WriteHeroIndex(const HeroIndex &index)
+{
+	const size_t size = HeroIndexHeaderSize + HeroIndexEntrySize * MAX_CHARACTERS;
+	std::unique_ptr<byte[]> data { new byte[size] {} };
+
+	byte *dst = data.get();
+	WriteLE32(dst, HeroIndexMagic);
+	WriteLE32(dst + 4, HeroIndexVersion);
+	WriteLE32(dst + 8, MAX_CHARACTERS);
+	dst += HeroIndexHeaderSize;
+
+	for (const HeroIndexEntry &entry : index) {
+		const _uiheroinfo &info = entry.info;
+		WriteLE64(dst, entry.fileSize);
+		WriteLE64(dst + 8, static_cast<uint64_t>(entry.fileTime));
+		dst[16] = static_cast<byte>(entry.flags);
+		dst[17] = static_cast<byte>(info.level);
+		dst[18] = static_cast<byte>(info.heroclass);
+		dst[19] = static_cast<byte>(info.herorank);
+		WriteLE16(dst + 20, info.strength);
+		WriteLE16(dst + 22, info.magic);
+		WriteLE16(dst + 24, info.dexterity);
+		WriteLE16(dst + 26, info.vitality);
+		memcpy(dst + 28, info.name, sizeof(info.name));
+		memcpy(dst + 48, entry.name, sizeof(entry.name));
+		dst += HeroIndexEntrySize;
+	}
+
+	const std::string path = GetHeroIndexPath();
+	FILE *file = OpenFile(path.c_str(), "wb");
+	if (file == nullptr) {
+		LogError("Failed to write hero index {}", path);
+		return;
+	}
+	if (std::fwrite(data.get(), size, 1, file) != 1)
+		LogError("Failed to write hero index {}", path);
+	std::fclose(file);
+}
+
+/**
+ * @brief Drops the cached roster entry of a slot whose save is about to change.
+ *
+ * The size and time stamp would catch most changes on their own, but a rewrite of the same size within the
+ * timestamp resolution would not be noticed.
+ */
+void InvalidateHeroIndexEntry(uint32_t saveNum)
+{
+	if (saveNum >= MAX_CHARACTERS)
+		return;
+	HeroIndex index;
+	ReadHeroIndex(index);
+	if ((index[saveNum].flags & HeroIndexValid) == 0)
+		return;
+	index[saveNum].flags = 0;
+	WriteHeroIndex(index);
+}
+
 SaveWriter GetSaveWriter(uint32_t saveNum)
 {
+	InvalidateHeroIndexEntry(saveNum);
 	return SaveWriter(GetSavePath(saveNum));
 }
 
@@ -628,34 +817,68 @@ bool pfile_ui_set_hero_infos(bool (*uiAddHeroInfo)(_uiheroinfo *))
 {
 	memset(hero_names, 0, sizeof(hero_names));
 
+	HeroIndex index;
+	ReadHeroIndex(index);
+	bool indexChanged = false;
+
 	for (uint32_t i = 0; i < MAX_CHARACTERS; i++) {
-		std::optional<SaveReader> archive = OpenSaveArchive(i);
-		if (archive) {
-			PlayerPack pkplr;
-			if (ReadHero(*archive, &pkplr)) {
-				_uiheroinfo uihero;
-				uihero.saveNumber = i;
-				strcpy(hero_names[i], pkplr.pName);
-				bool hasSaveGame = ArchiveContainsGame(*archive);
-				if (hasSaveGame)
-					pkplr.bIsHellfire = gbIsHellfireSaveGame ? 1 : 0;
-
-				Player &player = Players[0];
-
-				player = {};
-
-				if (UnPackPlayer(&pkplr, player, false)) {
-					LoadHeroItems(player);
-					RemoveEmptyInventory(player);
-					CalcPlrInv(player, false);
-
-					Game2UiPlayer(player, &uihero, hasSaveGame);
-					uiAddHeroInfo(&uihero);
+		HeroIndexEntry &entry = index[i];
+		HeroIndexEntry current;
+		const uint8_t exists = StatSaveFile(i, current);
+		const uint8_t hellfire = gbIsHellfire ? HeroIndexHellfire : 0;
+
+		if ((entry.flags & HeroIndexValid) == 0
+		    || (entry.flags & (HeroIndexExists | HeroIndexHellfire)) != (exists | hellfire)
+		    || entry.fileSize != current.fileSize
+		    || entry.fileTime != current.fileTime) {
+			entry.flags = HeroIndexValid | exists | hellfire;
+			entry.fileSize = current.fileSize;
+			entry.fileTime = current.fileTime;
+			entry.name[0] = '\0';
+			entry.info = {};
+			indexChanged = true;
+
+			std::optional<SaveReader> archive;
+			if (exists != 0)
+				archive = OpenSaveArchive(i);
+			if (archive) {
+				PlayerPack pkplr;
+				if (ReadHero(*archive, &pkplr)) {
+					_uiheroinfo &uihero = entry.info;
+					uihero.saveNumber = i;
+					strcpy(entry.name, pkplr.pName);
+					bool hasSaveGame = ArchiveContainsGame(*archive);
+					if (hasSaveGame)
+						pkplr.bIsHellfire = gbIsHellfireSaveGame ? 1 : 0;
+
+					Player &player = Players[0];
+
+					player = {};
+
+					if (UnPackPlayer(&pkplr, player, false)) {
+						LoadHeroItems(player);
+						RemoveEmptyInventory(player);
+						CalcPlrInv(player, false);
+
+						Game2UiPlayer(player, &uihero, hasSaveGame);
+						entry.flags |= HeroIndexListed;
+						if (hasSaveGame)
+							entry.flags |= HeroIndexHasSaved;
+					}
 				}
 			}
 		}
+
+		memcpy(hero_names[i], entry.name, sizeof(hero_names[i]));
+		if ((entry.flags & HeroIndexListed) != 0) {
+			_uiheroinfo uihero = entry.info;
+			uiAddHeroInfo(&uihero);
+		}
 	}
 
+	if (indexChanged)
+		WriteHeroIndex(index);
+
 	return true;
 }
 
@@ -711,6 +934,7 @@ bool pfile_delete_save(_uiheroinfo *heroInfo)
 	uint32_t saveNum = heroInfo->saveNumber;
 	if (saveNum < MAX_CHARACTERS) {
 		hero_names[saveNum][0] = '\0';
+		InvalidateHeroIndexEntry(saveNum);
 		RemoveFile(GetSavePath(saveNum).c_str());
 	}
 	return true;
@@ -21,6 +21,7 @@
 #include "engine/points_in_rectangle_range.hpp"
 #include "engine/random.hpp"
 #include "engine/render/clx_render.hpp"
+#include "engine/render/scrollrt.h"
 #include "engine/trn.hpp"
 #include "engine/world_tile.hpp"
 #include "gamemenu.h"
@@ -2191,6 +2192,9 @@ void InitPlayerGFX(Player &player)
 
 void ResetPlayerGFX(Player &player)
 {
+	// The sprites may still be referenced by the game view that is rendered in the background.
+	WaitForGameViewRendering();
+
 	player.AnimInfo.sprites = std::nullopt;
 	for (PlayerAnimationData &animData : player.AnimationData) {
 		animData.sprites = std::nullopt;
@@ -224,6 +224,8 @@ struct Player {
 
 	char _pName[PlayerNameLength];
 	Item InvBody[NUM_INVLOC];
+	/** @brief Bonuses of the items in InvBody, summed by CalcPlrItemVals. */
+	ItemStatBonusesCache InvBodyBonuses[NUM_INVLOC];
 	Item InvList[InventoryGridCells];
 	Item SpdList[MaxBeltItems];
 	Item HoldItem;
@@ -127,6 +127,13 @@ void SetCurrentPortal(size_t p)
 	portalindex = p;
 }
 
+dungeon_type GetPortalLevelType()
+{
+	if (leveltype != DTYPE_TOWN)
+		return DTYPE_TOWN;
+	return Portals[portalindex].ltype;
+}
+
 void GetPortalLevel()
 {
 	if (leveltype != DTYPE_TOWN) {
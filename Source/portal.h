@@ -32,6 +32,10 @@ void DeactivatePortal(int i);
 bool PortalOnLevel(size_t i);
 void RemovePortalMissile(int id);
 void SetCurrentPortal(size_t p);
+/**
+ * @brief Returns the type of the level that `GetPortalLevel` switches to.
+ */
+dungeon_type GetPortalLevelType();
 void GetPortalLevel();
 void GetPortalLvlPos();
 bool PosOkPortal(int lvl, Point position);
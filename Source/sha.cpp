@@ -17,16 +17,32 @@ uint32_t SHA1CircularShift(uint32_t word, size_t bits)
 {
 	// The SHA-like algorithm as originally implemented treated word as a signed value and used arithmetic right shifts
 	//  (sign-extending). This results in the high 32-`bits` bits being set to 1.
-	if ((word & (1 << 31)) != 0)
-		return (0xFFFFFFFF << bits) | (word >> (32 - bits));
-	return (word << bits) | (word >> (32 - bits));
+	// Right shifts of negative values are arithmetic on every compiler we support, so this does not need a branch.
+	return (word << bits) | static_cast<uint32_t>(static_cast<int32_t>(word) >> (32 - bits));
 }
 
-void SHA1ProcessMessageBlock(SHA1Context *context)
+template <uint32_t K, typename F>
+void SHA1Rounds(const uint32_t *w, std::uint32_t &a, std::uint32_t &b, std::uint32_t &c, std::uint32_t &d, std::uint32_t &e, F f)
+{
+	for (int i = 0; i < 20; i += 5) {
+		e += SHA1CircularShift(a, 5) + f(b, c, d) + w[i + 0] + K;
+		b = SHA1CircularShift(b, 30);
+		d += SHA1CircularShift(e, 5) + f(a, b, c) + w[i + 1] + K;
+		a = SHA1CircularShift(a, 30);
+		c += SHA1CircularShift(d, 5) + f(e, a, b) + w[i + 2] + K;
+		e = SHA1CircularShift(e, 30);
+		b += SHA1CircularShift(c, 5) + f(d, e, a) + w[i + 3] + K;
+		d = SHA1CircularShift(d, 30);
+		a += SHA1CircularShift(b, 5) + f(c, d, e) + w[i + 4] + K;
+		c = SHA1CircularShift(c, 30);
+	}
+}
+
+void SHA1ProcessMessageBlock(SHA1Context *context, const uint32_t data[BlockSize])
 {
 	std::uint32_t w[80];
 
-	memcpy(w, context->buffer, BlockSize * sizeof(uint32_t));
+	memcpy(w, data, BlockSize * sizeof(uint32_t));
 	for (int i = 16; i < 80; i++) {
 		w[i] = w[i - 16] ^ w[i - 14] ^ w[i - 8] ^ w[i - 3];
 	}
@@ -37,41 +53,12 @@ void SHA1ProcessMessageBlock(SHA1Context *context)
 	std::uint32_t d = context->state[3];
 	std::uint32_t e = context->state[4];
 
-	for (int i = 0; i < 20; i++) {
-		std::uint32_t temp = SHA1CircularShift(a, 5) + ((b & c) | ((~b) & d)) + e + w[i] + 0x5A827999;
-		e = d;
-		d = c;
-		c = SHA1CircularShift(b, 30);
-		b = a;
-		a = temp;
-	}
-
-	for (int i = 20; i < 40; i++) {
-		std::uint32_t temp = SHA1CircularShift(a, 5) + (b ^ c ^ d) + e + w[i] + 0x6ED9EBA1;
-		e = d;
-		d = c;
-		c = SHA1CircularShift(b, 30);
-		b = a;
-		a = temp;
-	}
-
-	for (int i = 40; i < 60; i++) {
-		std::uint32_t temp = SHA1CircularShift(a, 5) + ((b & c) | (b & d) | (c & d)) + e + w[i] + 0x8F1BBCDC;
-		e = d;
-		d = c;
-		c = SHA1CircularShift(b, 30);
-		b = a;
-		a = temp;
-	}
-
-	for (int i = 60; i < 80; i++) {
-		std::uint32_t temp = SHA1CircularShift(a, 5) + (b ^ c ^ d) + e + w[i] + 0xCA62C1D6;
-		e = d;
-		d = c;
-		c = SHA1CircularShift(b, 30);
-		b = a;
-		a = temp;
-	}
+	// Each group of five rounds rotates the roles of the variables back to where they started,
+	// which saves the register shuffling of the textbook loop.
+	SHA1Rounds<0x5A827999>(&w[0], a, b, c, d, e, [](uint32_t x, uint32_t y, uint32_t z) { return z ^ (x & (y ^ z)); });
+	SHA1Rounds<0x6ED9EBA1>(&w[20], a, b, c, d, e, [](uint32_t x, uint32_t y, uint32_t z) { return x ^ y ^ z; });
+	SHA1Rounds<0x8F1BBCDC>(&w[40], a, b, c, d, e, [](uint32_t x, uint32_t y, uint32_t z) { return (x & y) | (z & (x | y)); });
+	SHA1Rounds<0xCA62C1D6>(&w[60], a, b, c, d, e, [](uint32_t x, uint32_t y, uint32_t z) { return x ^ y ^ z; });
 
 	context->state[0] += a;
 	context->state[1] += b;
@@ -89,8 +76,7 @@ void SHA1Result(SHA1Context &context, uint32_t messageDigest[SHA1HashSize])
 
 void SHA1Calculate(SHA1Context &context, const uint32_t data[BlockSize])
 {
-	memcpy(&context.buffer[0], data, BlockSize * sizeof(uint32_t));
-	SHA1ProcessMessageBlock(&context);
+	SHA1ProcessMessageBlock(&context, data);
 }
 
 } // namespace devilution
@@ -16,7 +16,6 @@ constexpr size_t SHA1HashSize = 5;
 
 struct SHA1Context {
 	uint32_t state[SHA1HashSize] = { 0x67452301, 0xEFCDAB89, 0x98BADCFE, 0x10325476, 0xC3D2E1F0 };
-	uint32_t buffer[BlockSize];
 };
 
 void SHA1Result(SHA1Context &context, uint32_t messageDigest[SHA1HashSize]);
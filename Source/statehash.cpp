@@ -0,0 +1,149 @@
+/**
+ * @file statehash.cpp
+ *
+ * Implementation of the hash over the simulated game state, used to detect diverging simulations.
+ */
+#include "statehash.h"
+
+#include "items.h"
+#include "missiles.h"
+#include "monster.h"
+#include "objects.h"
+#include "player.h"
+
+namespace devilution {
+
+namespace {
+
+/** @brief 32-bit FNV-1a over the added values. */
+class StateHasher {
+public:
+	template <typename T>
+	void add(T value)
+	{
+		const auto *bytes = reinterpret_cast<const uint8_t *>(&value);
+		for (size_t i = 0; i < sizeof(value); i++) {
+			hash_ ^= bytes[i];
+			hash_ *= 16777619U;
+		}
+	}
+
+	void add(Point point)
+	{
+		add(point.x);
+		add(point.y);
+	}
+
+	void add(WorldTilePosition position)
+	{
+		add(position.x);
+		add(position.y);
+	}
+
+	[[nodiscard]] uint32_t value() const
+	{
+		return hash_;
+	}
+
+private:
+	uint32_t hash_ = 2166136261U;
+};
+
+uint32_t HashPlayers()
+{
+	StateHasher hasher;
+	for (const Player &player : Players) {
+		if (!player.plractive || !player.isOnActiveLevel())
+			continue;
+		hasher.add(player.position.tile);
+		hasher.add(player.position.future);
+		hasher.add(player._pmode);
+		hasher.add(player._pdir);
+		hasher.add(player._pHitPoints);
+		hasher.add(player._pMana);
+		hasher.add(player._pExperience);
+		hasher.add(player._pGold);
+	}
+	return hasher.value();
+}
+
+uint32_t HashMonsters()
+{
+	StateHasher hasher;
+	for (size_t i = 0; i < ActiveMonsterCount; i++) {
+		const Monster &monster = Monsters[ActiveMonsters[i]];
+		hasher.add(ActiveMonsters[i]);
+		hasher.add(monster.position.tile);
+		hasher.add(monster.position.future);
+		hasher.add(monster.mode);
+		hasher.add(monster.direction);
+		hasher.add(monster.hitPoints);
+		hasher.add(monster.flags);
+		hasher.add(monster.enemy);
+		hasher.add(monster.aiSeed);
+		hasher.add(monster.goal);
+		hasher.add(monster.var1);
+		hasher.add(monster.var2);
+	}
+	return hasher.value();
+}
+
+uint32_t HashMissiles()
+{
+	StateHasher hasher;
+	for (const Missile &missile : Missiles) {
+		hasher.add(missile._mitype);
+		hasher.add(missile.position.tile);
+		hasher.add(missile._mirange);
+		hasher.add(missile._misource);
+		hasher.add(missile._midam);
+		hasher.add(missile.var1);
+		hasher.add(missile.var2);
+	}
+	return hasher.value();
+}
+
+uint32_t HashItems()
+{
+	StateHasher hasher;
+	for (uint8_t i = 0; i < ActiveItemCount; i++) {
+		const Item &item = Items[ActiveItems[i]];
+		hasher.add(ActiveItems[i]);
+		hasher.add(item.position);
+		hasher.add(item.IDidx);
+		hasher.add(item._iSeed);
+		hasher.add(item._iCreateInfo);
+	}
+	return hasher.value();
+}
+
+uint32_t HashObjects()
+{
+	StateHasher hasher;
+	for (int i = 0; i < ActiveObjectCount; i++) {
+		const Object &object = Objects[ActiveObjects[i]];
+		hasher.add(ActiveObjects[i]);
+		hasher.add(object._otype);
+		hasher.add(object.position);
+		hasher.add(object._oSelFlag);
+		hasher.add(object._oBreak);
+		hasher.add(object._oVar1);
+		hasher.add(object._oVar4);
+	}
+	return hasher.value();
+}
+
+} // namespace
+
+GameStateHash ComputeGameStateHash()
+{
+	return {
+		HashPlayers(),
+		HashMonsters(),
+		HashMissiles(),
+		HashItems(),
+		HashObjects(),
+	};
+}
+
+} // namespace devilution
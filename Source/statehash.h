@@ -0,0 +1,44 @@
+/**
+ * @file statehash.h
+ *
+ * Interface of the hash over the simulated game state, used to detect diverging simulations.
+ */
+#pragma once
+
+#include <cstdint>
+
+namespace devilution {
+
+/**
+ * @brief Hashes of the parts of the game state that every peer simulates in lockstep.
+ *
+ * Only state that is identical on all peers is included, e.g. no visibility or rendering state.
+ */
+struct GameStateHash {
+	uint32_t players;
+	uint32_t monsters;
+	uint32_t missiles;
+	uint32_t items;
+	uint32_t objects;
+
+	bool operator==(const GameStateHash &other) const
+	{
+		return players == other.players
+		    && monsters == other.monsters
+		    && missiles == other.missiles
+		    && items == other.items
+		    && objects == other.objects;
+	}
+
+	bool operator!=(const GameStateHash &other) const
+	{
+		return !(*this == other);
+	}
+};
+
+/**
+ * @brief Hashes the players, monsters, missiles, items and objects of the active level.
+ */
+GameStateHash ComputeGameStateHash();
+
+} // namespace devilution
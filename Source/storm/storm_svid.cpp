@@ -1,8 +1,11 @@
 #include "storm/storm_svid.h"
 
+#include <algorithm>
+#include <array>
 #include <cstddef>
 #include <cstdint>
 #include <cstring>
+#include <memory>
 
 #include <SmackerDecoder.h>
 
@@ -18,17 +21,25 @@
 #include "utils/display.h"
 #include "utils/log.hpp"
 #include "utils/sdl_compat.h"
+#include "utils/sdl_cond.h"
+#include "utils/sdl_mutex.h"
+#include "utils/sdl_thread.h"
 #include "utils/sdl_wrap.h"
 #include "utils/stdcompat/optional.hpp"
 
 namespace devilution {
 namespace {
 
+constexpr size_t NumColors = 256;
+
 #ifndef NOSOUND
 std::optional<Aulib::Stream> SVidAudioStream;
 PushAulibDecoder *SVidAudioDecoder;
 std::uint8_t SVidAudioDepth;
 std::unique_ptr<int16_t[]> SVidAudioBuffer;
+size_t SVidAudioBufferSize;
+/** Length in bytes of the audio in `SVidAudioBuffer` that belongs to the current frame. */
+size_t SVidAudioLength;
 #endif
 
 uint32_t SVidWidth, SVidHeight;
@@ -39,6 +50,150 @@ SmackerHandle SVidHandle;
 std::unique_ptr<uint8_t[]> SVidFrameBuffer;
 SDLPaletteUniquePtr SVidPalette;
 SDLSurfaceUniquePtr SVidSurface;
+/** The current frame converted to the output format, kept between frames so that scaling does not allocate. */
+SDLSurfaceUniquePtr SVidConvertedSurface;
+/** Whether the palette changed with the current frame. */
+bool SVidPaletteChanged;
+uint8_t SVidPaletteData[NumColors * 3];
+/** `SVidPaletteData` mapped to a 32-bit output format, see `ConvertFrame`. */
+std::array<uint32_t, NumColors> SVidPaletteLookup;
+/** Output format `SVidPaletteLookup` was built for, nullptr when it needs rebuilding. */
+const SDL_PixelFormat *SVidPaletteLookupFormat;
+
+/**
+ * @brief A decoded frame together with the palette and audio that came with it.
+ */
+struct SVidFrame {
+	std::unique_ptr<uint8_t[]> pixels;
+	uint8_t palette[NumColors * 3];
+	bool paletteChanged;
+#ifndef NOSOUND
+	std::unique_ptr<int16_t[]> audio;
+	size_t audioLength;
+#endif
+	/** Set instead of decoding a frame once a video that does not loop has ended. */
+	bool end;
+};
+
+/**
+ * @brief Decodes the frames following the current one on a separate thread, so that slow frames do not stall playback.
+ *
+ * Once started, only the decoder's thread uses `SVidHandle` until the decoder is destroyed.
+ */
+class SVidDecoder {
+public:
+	SVidDecoder()
+	{
+		for (SVidFrame &frame : frames_) {
+			frame.pixels = std::unique_ptr<uint8_t[]> { new uint8_t[static_cast<size_t>(SVidWidth * SVidHeight)] };
+#ifndef NOSOUND
+			if (SVidAudioBuffer != nullptr)
+				frame.audio = std::unique_ptr<int16_t[]> { new int16_t[SVidAudioBufferSize] };
+#endif
+		}
+		// Started once the frames are allocated.
+		thread_ = SdlThread(ThreadMain, this);
+	}
+
+	~SVidDecoder()
+	{
+		mutex_.lock();
+		quit_ = true;
+		slotFree_.signal();
+		mutex_.unlock();
+		thread_.join();
+	}
+
+	SVidDecoder(const SVidDecoder &) = delete;
+	SVidDecoder &operator=(const SVidDecoder &) = delete;
+
+	/**
+	 * @brief Blocks until the next frame has been decoded and returns it, it stays valid until `pop` is called.
+	 */
+	const SVidFrame &front()
+	{
+		mutex_.lock();
+		while (count_ == 0)
+			frameReady_.wait(mutex_);
+		const SVidFrame &frame = frames_[head_];
+		mutex_.unlock();
+		return frame;
+	}
+
+	/**
+	 * @brief Hands the frame returned by `front` back to the decoder.
+	 */
+	void pop()
+	{
+		mutex_.lock();
+		head_ = (head_ + 1) % frames_.size();
+		count_--;
+		slotFree_.signal();
+		mutex_.unlock();
+	}
+
+private:
+	static int SDLCALL ThreadMain(void *data);
+
+	static bool Decode(SVidFrame &frame);
+
+	SdlMutex mutex_;
+	SdlCond frameReady_;
+	SdlCond slotFree_;
+	std::array<SVidFrame, 3> frames_;
+	size_t head_ = 0;
+	size_t count_ = 0;
+	bool quit_ = false;
+	SdlThread thread_;
+};
+
+std::unique_ptr<SVidDecoder> SVidFrameDecoder;
+
+bool SVidDecoder::Decode(SVidFrame &frame)
+{
+	if (Smacker_GetCurrentFrameNum(SVidHandle) >= Smacker_GetNumFrames(SVidHandle)) {
+		if (!SVidLoop) {
+			frame.end = true;
+			return false;
+		}
+
+		Smacker_Rewind(SVidHandle);
+	}
+
+	Smacker_GetNextFrame(SVidHandle);
+	Smacker_GetFrame(SVidHandle, frame.pixels.get());
+	frame.paletteChanged = Smacker_DidPaletteChange(SVidHandle);
+	if (frame.paletteChanged)
+		Smacker_GetPalette(SVidHandle, frame.palette);
+#ifndef NOSOUND
+	if (frame.audio != nullptr)
+		frame.audioLength = Smacker_GetAudioData(SVidHandle, 0, frame.audio.get());
+#endif
+	frame.end = false;
+	return true;
+}
+
+int SDLCALL SVidDecoder::ThreadMain(void *data)
+{
+	auto &decoder = *static_cast<SVidDecoder *>(data);
+	decoder.mutex_.lock();
+	while (true) {
+		while (!decoder.quit_ && decoder.count_ == decoder.frames_.size())
+			decoder.slotFree_.wait(decoder.mutex_);
+		if (decoder.quit_)
+			break;
+		SVidFrame &frame = decoder.frames_[(decoder.head_ + decoder.count_) % decoder.frames_.size()];
+		decoder.mutex_.unlock();
+		const bool decoded = Decode(frame);
+		decoder.mutex_.lock();
+		decoder.count_++;
+		decoder.frameReady_.signal();
+		if (!decoded)
+			break;
+	}
+	decoder.mutex_.unlock();
+	return 0;
+}
 
 bool IsLandscapeFit(unsigned long srcW, unsigned long srcH, unsigned long dstW, unsigned long dstH)
 {
@@ -118,33 +273,36 @@ bool HasAudio()
 
 bool SVidLoadNextFrame()
 {
-	if (Smacker_GetCurrentFrameNum(SVidHandle) >= Smacker_GetNumFrames(SVidHandle)) {
-		if (!SVidLoop) {
-			return false;
-		}
-
-		Smacker_Rewind(SVidHandle);
-	}
+	const SVidFrame &frame = SVidFrameDecoder->front();
+	if (frame.end)
+		return false;
 
 	SVidFrameEnd += SVidFrameLength;
 
-	Smacker_GetNextFrame(SVidHandle);
-	Smacker_GetFrame(SVidHandle, SVidFrameBuffer.get());
+	memcpy(SVidFrameBuffer.get(), frame.pixels.get(), static_cast<size_t>(SVidWidth * SVidHeight));
+	SVidPaletteChanged = frame.paletteChanged;
+	if (frame.paletteChanged)
+		memcpy(SVidPaletteData, frame.palette, sizeof(SVidPaletteData));
+#ifndef NOSOUND
+	if (frame.audio != nullptr) {
+		SVidAudioLength = frame.audioLength;
+		memcpy(SVidAudioBuffer.get(), frame.audio.get(), frame.audioLength);
+	}
+#endif
+	SVidFrameDecoder->pop();
 
 	return true;
 }
 
 void UpdatePalette()
 {
-	constexpr size_t NumColors = 256;
-	uint8_t paletteData[NumColors * 3];
-	Smacker_GetPalette(SVidHandle, paletteData);
+	SVidPaletteLookupFormat = nullptr;
 
 	SDL_Color *colors = SVidPalette->colors;
 	for (unsigned i = 0; i < NumColors; ++i) {
-		colors[i].r = paletteData[i * 3];
-		colors[i].g = paletteData[i * 3 + 1];
-		colors[i].b = paletteData[i * 3 + 2];
+		colors[i].r = SVidPaletteData[i * 3];
+		colors[i].g = SVidPaletteData[i * 3 + 1];
+		colors[i].b = SVidPaletteData[i * 3 + 2];
 #ifndef USE_SDL1
 		colors[i].a = SDL_ALPHA_OPAQUE;
 #endif
@@ -165,11 +323,41 @@ void UpdatePalette()
 #endif
 }
 
+/**
+ * @brief Converts the current frame to a 32-bit surface through a palette lookup table, replacing SDL's general-purpose blitter.
+ * @return false if `dst` is not a 32-bit surface.
+ */
+bool ConvertFrame(SDL_Surface *dst)
+{
+	if (dst->format->BytesPerPixel != 4)
+		return false;
+
+	if (SVidPaletteLookupFormat != dst->format) {
+		for (unsigned i = 0; i < NumColors; ++i)
+			SVidPaletteLookup[i] = SDL_MapRGB(dst->format, SVidPaletteData[i * 3], SVidPaletteData[i * 3 + 1], SVidPaletteData[i * 3 + 2]);
+		SVidPaletteLookupFormat = dst->format;
+	}
+
+	const int width = std::min(static_cast<int>(SVidWidth), dst->w);
+	const int height = std::min(static_cast<int>(SVidHeight), dst->h);
+	if (SDL_MUSTLOCK(dst) && SDL_LockSurface(dst) <= -1)
+		ErrSdl();
+	for (int y = 0; y < height; y++) {
+		const uint8_t *src = &SVidFrameBuffer[static_cast<size_t>(y) * SVidWidth];
+		auto *out = reinterpret_cast<uint32_t *>(static_cast<uint8_t *>(dst->pixels) + static_cast<ptrdiff_t>(y) * dst->pitch);
+		for (int x = 0; x < width; x++)
+			out[x] = SVidPaletteLookup[src[x]];
+	}
+	if (SDL_MUSTLOCK(dst))
+		SDL_UnlockSurface(dst);
+	return true;
+}
+
 bool BlitFrame()
 {
 #ifndef USE_SDL1
 	if (renderer != nullptr) {
-		if (SDL_BlitSurface(SVidSurface.get(), nullptr, GetOutputSurface(), nullptr) <= -1) {
+		if (!ConvertFrame(GetOutputSurface()) && SDL_BlitSurface(SVidSurface.get(), nullptr, GetOutputSurface(), nullptr) <= -1) {
 			Log("{}", SDL_GetError());
 			return false;
 		}
@@ -207,12 +395,16 @@ bool BlitFrame()
 		} else {
 			// The source surface is always 8-bit, and the output surface is never 8-bit in this branch.
 			// We must convert to the output format before calling SDL_BlitScaled.
+			if (SVidConvertedSurface == nullptr) {
 #ifdef USE_SDL1
-			SDLSurfaceUniquePtr converted = SDLWrap::ConvertSurface(SVidSurface.get(), ghMainWnd->format, 0);
+				SVidConvertedSurface = SDLWrap::ConvertSurface(SVidSurface.get(), ghMainWnd->format, 0);
 #else
-			SDLSurfaceUniquePtr converted = SDLWrap::ConvertSurfaceFormat(SVidSurface.get(), wndFormat, 0);
+				SVidConvertedSurface = SDLWrap::ConvertSurfaceFormat(SVidSurface.get(), wndFormat, 0);
 #endif
-			if (SDL_BlitScaled(converted.get(), nullptr, outputSurface, &outputRect) <= -1) {
+			} else if (!ConvertFrame(SVidConvertedSurface.get()) && SDL_BlitSurface(SVidSurface.get(), nullptr, SVidConvertedSurface.get(), nullptr) <= -1) {
+				ErrSdl();
+			}
+			if (SDL_BlitScaled(SVidConvertedSurface.get(), nullptr, outputSurface, &outputRect) <= -1) {
 				Log("{}", SDL_GetError());
 				return false;
 			}
@@ -257,7 +449,8 @@ bool SVidPlayBegin(const char *filename, int flags)
 		sound_stop(); // Stop in-progress music and sound effects
 
 		SVidAudioDepth = audioInfo.bitsPerSample;
-		SVidAudioBuffer = std::unique_ptr<int16_t[]> { new int16_t[audioInfo.idealBufferSize] };
+		SVidAudioBufferSize = audioInfo.idealBufferSize;
+		SVidAudioBuffer = std::unique_ptr<int16_t[]> { new int16_t[SVidAudioBufferSize] };
 		auto decoder = std::make_unique<PushAulibDecoder>(audioInfo.nChannels, audioInfo.sampleRate);
 		SVidAudioDecoder = decoder.get();
 		SVidAudioStream.emplace(/*rwops=*/nullptr, std::move(decoder), CreateAulibResampler(audioInfo.sampleRate), /*closeRw=*/false);
@@ -303,6 +496,12 @@ bool SVidPlayBegin(const char *filename, int flags)
 	// Decode first frame.
 	Smacker_GetNextFrame(SVidHandle);
 	Smacker_GetFrame(SVidHandle, SVidFrameBuffer.get());
+	SVidPaletteChanged = Smacker_DidPaletteChange(SVidHandle);
+	Smacker_GetPalette(SVidHandle, SVidPaletteData);
+#ifndef NOSOUND
+	if (SVidAudioBuffer != nullptr)
+		SVidAudioLength = Smacker_GetAudioData(SVidHandle, 0, SVidAudioBuffer.get());
+#endif
 
 	// Create the surface from the frame buffer data.
 	// It will be rendered in `SVidPlayContinue`, called immediately after this function.
@@ -318,6 +517,9 @@ bool SVidPlayBegin(const char *filename, int flags)
 	SVidPalette = SDLWrap::AllocPalette();
 	UpdatePalette();
 
+	// The following frames are decoded ahead while this one is shown.
+	SVidFrameDecoder = std::make_unique<SVidDecoder>();
+
 	SVidFrameEnd = SDL_GetTicks() * 1000.0 + SVidFrameLength;
 
 	return true;
@@ -325,7 +527,7 @@ bool SVidPlayBegin(const char *filename, int flags)
 
 bool SVidPlayContinue()
 {
-	if (Smacker_DidPaletteChange(SVidHandle)) {
+	if (SVidPaletteChanged) {
 		UpdatePalette();
 	}
 
@@ -336,7 +538,7 @@ bool SVidPlayContinue()
 #ifndef NOSOUND
 	if (HasAudio()) {
 		std::int16_t *buf = SVidAudioBuffer.get();
-		const auto len = Smacker_GetAudioData(SVidHandle, 0, buf);
+		const auto len = SVidAudioLength;
 		if (SVidAudioDepth == 16) {
 			SVidAudioDecoder->PushSamples(buf, len / 2);
 		} else {
@@ -370,11 +572,13 @@ void SVidPlayEnd()
 	}
 #endif
 
+	SVidFrameDecoder = nullptr;
 	if (SVidHandle.isValid)
 		Smacker_Close(SVidHandle);
 
 	SVidPalette = nullptr;
 	SVidSurface = nullptr;
+	SVidConvertedSurface = nullptr;
 	SVidFrameBuffer = nullptr;
 
 #ifndef USE_SDL1
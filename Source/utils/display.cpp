@@ -26,6 +26,7 @@
 #include "controls/touch/gamepad.h"
 #include "engine/backbuffer_state.hpp"
 #include "engine/dx.h"
+#include "engine/render/scrollrt.h"
 #include "options.h"
 #include "utils/log.hpp"
 #include "utils/sdl_geometry.h"
@@ -382,6 +383,8 @@ void ReinitializeRenderer()
 	if (ghMainWnd == nullptr)
 		return;
 
+	DiscardGameViewRendering();
+
 #ifdef USE_SDL1
 	const SDL_VideoInfo &current = *SDL_GetVideoInfo();
 	Size windowSize = { current.current_w, current.current_h };
@@ -208,6 +208,35 @@ bool GetFileSize(const char *path, std::uintmax_t *size)
 #endif
 }
 
+bool GetFileModificationTime(const char *path, std::int64_t *mtime)
+{
+#if defined(_WIN64) || defined(_WIN32)
+	WIN32_FILE_ATTRIBUTE_DATA attr;
+#if defined(NXDK)
+	if (!GetFileAttributesExA(path, GetFileExInfoStandard, &attr)) {
+		return false;
+	}
+#else
+	const auto pathUtf16 = ToWideChar(path);
+	if (pathUtf16 == nullptr) {
+		LogError("UTF-8 -> UTF-16 conversion error code {}", ::GetLastError());
+		return false;
+	}
+	if (!GetFileAttributesExW(&pathUtf16[0], GetFileExInfoStandard, &attr)) {
+		return false;
+	}
+#endif
+	*mtime = static_cast<std::int64_t>(static_cast<std::uint64_t>(attr.ftLastWriteTime.dwHighDateTime) << 32 | attr.ftLastWriteTime.dwLowDateTime);
+	return true;
+#else
+	struct ::stat statResult;
+	if (::stat(path, &statResult) == -1)
+		return false;
+	*mtime = static_cast<std::int64_t>(statResult.st_mtime);
+	return true;
+#endif
+}
+
 bool CreateDir(const char *path)
 {
 #ifdef DVL_HAS_FILESYSTEM
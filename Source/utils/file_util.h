@@ -29,6 +29,13 @@ string_view Dirname(string_view path);
 bool FileExistsAndIsWriteable(const char *path);
 bool GetFileSize(const char *path, std::uintmax_t *size);
 
+/**
+ * @brief Returns the last modification time of the file in platform-specific units.
+ *
+ * The value is only meant to be compared with other values returned by this function.
+ */
+bool GetFileModificationTime(const char *path, std::int64_t *mtime);
+
 /**
  * @brief Creates a single directory (non-recursively).
  *
@@ -20,6 +20,7 @@
 #define MO_MAGIC 0x950412de
 
 std::string forceLocale;
+uint32_t TranslationGeneration = 1;
 
 namespace {
 
@@ -329,6 +330,39 @@ string_view LanguageTranslate(const char *key)
 	return GetTranslation(it->second);
 }
 
+namespace {
+
+/**
+ * @brief Stores `value` in the cache, unless another thread is filling it or already has.
+ */
+void FillTranslationCache(TranslationCache &cache, string_view value)
+{
+	if (cache.filling.exchange(true, std::memory_order_acquire))
+		return;
+	// Another thread may have filled the cache since the caller checked it, and readers may be using its value.
+	if (cache.generation.load(std::memory_order_relaxed) != TranslationGeneration) {
+		cache.value = value;
+		cache.generation.store(TranslationGeneration, std::memory_order_release);
+	}
+	cache.filling.store(false, std::memory_order_release);
+}
+
+} // namespace
+
+string_view LanguageTranslate(TranslationCache &cache, const char *key)
+{
+	const string_view value = LanguageTranslate(key);
+	FillTranslationCache(cache, value);
+	return value;
+}
+
+string_view LanguageParticularTranslate(TranslationCache &cache, string_view context, string_view message)
+{
+	const string_view value = LanguageParticularTranslate(context, message);
+	FillTranslationCache(cache, value);
+	return value;
+}
+
 bool HasTranslation(const std::string &locale)
 {
 	if (locale == "en") {
@@ -360,6 +394,8 @@ void LanguageInitialize()
 	translation = { {}, {} };
 	translationKeys = nullptr;
 	translationValues = nullptr;
+	// Any translation cached so far may point into the values released above.
+	TranslationGeneration++;
 
 	const std::string lang(GetLanguageCode());
 
@@ -1,12 +1,15 @@
 #pragma once
 
+#include <atomic>
+#include <cstdint>
 #include <string>
 
 #include "utils/stdcompat/string_view.hpp"
 
-#define _(x) LanguageTranslate(x)
+// Call sites with string literal keys cache their translation, see TranslationCache.
+#define _(x) LanguageTranslateAt<#x[0] == '"'>(x, []() -> TranslationCache & { static TranslationCache cache; return cache; })
 #define ngettext(x, y, z) LanguagePluralTranslate(x, y, z)
-#define pgettext(context, x) LanguageParticularTranslate(context, x)
+#define pgettext(context, x) LanguageParticularTranslateAt<#context[0] == '"' && #x[0] == '"'>(context, x, []() -> TranslationCache & { static TranslationCache cache; return cache; })
 #define N_(x) (x)
 #define P_(context, x) (x)
 
@@ -42,5 +45,51 @@ devilution::string_view LanguagePluralTranslate(const char *singular, devilution
  */
 devilution::string_view LanguageParticularTranslate(devilution::string_view context, devilution::string_view message);
 
+/** @brief Incremented whenever the loaded translations change, which invalidates all TranslationCache instances. */
+extern uint32_t TranslationGeneration;
+
+/**
+ * @brief The translation of one call site whose key is a string literal.
+ *
+ * The key of such a call site never changes, so the lookup only needs to be repeated after a language change.
+ * A call site may run on several threads at once: `generation` is published after `value` is written, and only one
+ * thread at a time fills the cache, the others look the key up without it meanwhile.
+ */
+struct TranslationCache {
+	std::atomic<uint32_t> generation { 0 };
+	/** @brief Set while a thread fills the cache. */
+	std::atomic<bool> filling { false };
+	devilution::string_view value;
+};
+
+devilution::string_view LanguageTranslate(TranslationCache &cache, const char *key);
+devilution::string_view LanguageParticularTranslate(TranslationCache &cache, devilution::string_view context, devilution::string_view message);
+
+template <bool IsLiteral, typename Key, typename GetCache>
+devilution::string_view LanguageTranslateAt(const Key &key, GetCache getCache)
+{
+	if constexpr (IsLiteral) {
+		TranslationCache &cache = getCache();
+		if (cache.generation.load(std::memory_order_acquire) == TranslationGeneration)
+			return cache.value;
+		return LanguageTranslate(cache, key);
+	} else {
+		return LanguageTranslate(key);
+	}
+}
+
+template <bool IsLiteral, typename Context, typename Message, typename GetCache>
+devilution::string_view LanguageParticularTranslateAt(const Context &context, const Message &message, GetCache getCache)
+{
+	if constexpr (IsLiteral) {
+		TranslationCache &cache = getCache();
+		if (cache.generation.load(std::memory_order_acquire) == TranslationGeneration)
+			return cache.value;
+		return LanguageParticularTranslate(cache, context, message);
+	} else {
+		return LanguageParticularTranslate(context, message);
+	}
+}
+
 // Chinese and Japanese, and Korean small font is 16px instead of a 12px one for readability.
 bool IsSmallFontTall();
@@ -0,0 +1,115 @@
+#include "utils/pcm_aulib_decoder.h"
+
+#include <algorithm>
+#include <limits>
+#include <vector>
+
+#include <Aulib/DecoderDrmp3.h>
+#include <Aulib/DecoderDrwav.h>
+
+#include "appfat.h"
+#include "utils/log.hpp"
+
+namespace devilution {
+
+namespace {
+
+constexpr float SampleScale = std::numeric_limits<std::int16_t>::max() + 1.F;
+
+std::unique_ptr<Aulib::Decoder> CreateFileDecoder(bool isMp3)
+{
+	if (isMp3)
+		return std::make_unique<Aulib::DecoderDrmp3>();
+	return std::make_unique<Aulib::DecoderDrwav>();
+}
+
+std::int16_t FloatToSample(float sample)
+{
+	const float scaled = sample * SampleScale;
+	return static_cast<std::int16_t>(std::clamp(scaled, static_cast<float>(std::numeric_limits<std::int16_t>::min()), static_cast<float>(std::numeric_limits<std::int16_t>::max())));
+}
+
+} // namespace
+
+std::shared_ptr<const PcmBuffer> DecodeToPcm(SDL_RWops *handle, bool isMp3)
+{
+	std::vector<std::int16_t> samples;
+	int channels;
+	int rate;
+	{
+		std::unique_ptr<Aulib::Decoder> decoder = CreateFileDecoder(isMp3);
+		if (!decoder->open(handle)) {
+			SDL_RWclose(handle);
+			return nullptr;
+		}
+		channels = decoder->getChannels();
+		rate = decoder->getRate();
+		samples.reserve(static_cast<std::size_t>(decoder->duration().count() * rate / 1000000 * channels));
+
+		constexpr int ChunkSize = 4096;
+		float chunk[ChunkSize];
+		while (true) {
+			bool callAgain = false;
+			const int decoded = decoder->decode(chunk, ChunkSize, callAgain);
+			if (decoded <= 0 && !callAgain)
+				break;
+			for (int i = 0; i < decoded; ++i)
+				samples.push_back(FloatToSample(chunk[i]));
+		}
+	}
+	SDL_RWclose(handle);
+
+	if (samples.empty() || channels <= 0)
+		return nullptr;
+
+	auto buffer = std::make_shared<PcmBuffer>();
+	buffer->samples.reset(new std::int16_t[samples.size()]);
+	std::copy(samples.begin(), samples.end(), buffer->samples.get());
+	buffer->numSamples = samples.size();
+	buffer->channels = channels;
+	buffer->rate = rate;
+	return buffer;
+}
+
+bool PcmAulibDecoder::open([[maybe_unused]] SDL_RWops *rwops)
+{
+	assert(rwops == nullptr);
+	return true;
+}
+
+bool PcmAulibDecoder::rewind()
+{
+	pos_ = 0;
+	return true;
+}
+
+std::chrono::microseconds PcmAulibDecoder::duration() const
+{
+	const auto frames = static_cast<std::int64_t>(buffer_->numSamples / buffer_->channels);
+	return std::chrono::microseconds { frames * 1000000 / buffer_->rate };
+}
+
+bool PcmAulibDecoder::seekToTime(std::chrono::microseconds pos)
+{
+	const auto frame = static_cast<std::size_t>(pos.count() * buffer_->rate / 1000000);
+	const std::size_t sample = frame * buffer_->channels;
+	if (sample > buffer_->numSamples)
+		return false;
+	pos_ = sample;
+	return true;
+}
+
+int PcmAulibDecoder::doDecoding(float buf[], int len, bool &callAgain)
+{
+	callAgain = false;
+
+	const std::size_t remaining = buffer_->numSamples - pos_;
+	const int count = static_cast<int>(std::min<std::size_t>(remaining, static_cast<std::size_t>(len)));
+	const std::int16_t *samples = &buffer_->samples[pos_];
+	for (int i = 0; i < count; ++i)
+		buf[i] = static_cast<float>(samples[i]) / SampleScale;
+	pos_ += count;
+	return count;
+}
+
+} // namespace devilution
@@ -0,0 +1,86 @@
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+#include <Aulib/Decoder.h>
+#include <SDL.h>
+
+namespace devilution {
+
+/**
+ * @brief A fully decoded sound, shared by every voice that plays it.
+ */
+struct PcmBuffer {
+	/** Interleaved 16-bit samples. */
+	std::unique_ptr<std::int16_t[]> samples;
+	/** Number of samples in `samples`, counting every channel. */
+	std::size_t numSamples;
+	int channels;
+	int rate;
+
+	[[nodiscard]] std::size_t SizeInBytes() const
+	{
+		return numSamples * sizeof(samples[0]);
+	}
+};
+
+/**
+ * @brief Decodes a complete WAV or MP3 file to 16-bit PCM.
+ * @param handle File data, closed by this function.
+ * @param isMp3 Whether the data is an MP3
+ * @return The decoded sound or nullptr on failure
+ */
+std::shared_ptr<const PcmBuffer> DecodeToPcm(SDL_RWops *handle, bool isMp3);
+
+/**
+ * @brief A Decoder interface implementation that plays a sound that has already been decoded by `DecodeToPcm`.
+ */
+class PcmAulibDecoder final : public ::Aulib::Decoder {
+public:
+	explicit PcmAulibDecoder(std::shared_ptr<const PcmBuffer> buffer)
+	    : buffer_(std::move(buffer))
+	{
+	}
+
+	/**
+	 * @brief Replaces the sound to play. Must only be called while the owning stream is not playing.
+	 */
+	void SetBuffer(std::shared_ptr<const PcmBuffer> buffer) noexcept
+	{
+		buffer_ = std::move(buffer);
+		pos_ = 0;
+	}
+
+	[[nodiscard]] const std::shared_ptr<const PcmBuffer> &GetBuffer() const
+	{
+		return buffer_;
+	}
+
+	bool open(SDL_RWops *rwops) override;
+
+	[[nodiscard]] int getChannels() const override
+	{
+		return buffer_->channels;
+	}
+
+	[[nodiscard]] int getRate() const override
+	{
+		return buffer_->rate;
+	}
+
+	bool rewind() override;
+	[[nodiscard]] std::chrono::microseconds duration() const override;
+	bool seekToTime(std::chrono::microseconds pos) override;
+
+protected:
+	int doDecoding(float buf[], int len, bool &callAgain) override;
+
+private:
+	std::shared_ptr<const PcmBuffer> buffer_;
+	std::size_t pos_ = 0;
+};
+
+} // namespace devilution
@@ -0,0 +1,57 @@
+#pragma once
+
+#include <SDL_mutex.h>
+
+#include "appfat.h"
+#include "utils/sdl_mutex.h"
+
+namespace devilution {
+
+/*
+ * RAII wrapper for SDL_cond.
+ */
+class SdlCond final {
+public:
+	SdlCond()
+	    : cond_(SDL_CreateCond())
+	{
+		if (cond_ == nullptr)
+			ErrSdl();
+	}
+
+	~SdlCond()
+	{
+		SDL_DestroyCond(cond_);
+	}
+
+	SdlCond(const SdlCond &) = delete;
+	SdlCond(SdlCond &&) = delete;
+	SdlCond &operator=(const SdlCond &) = delete;
+	SdlCond &operator=(SdlCond &&) = delete;
+
+	/**
+	 * @brief Unlocks the given (locked) mutex, waits to be signaled and locks the mutex again.
+	 */
+	void wait(SdlMutex &mutex) noexcept
+	{
+		if (SDL_CondWait(cond_, mutex.get()) == -1)
+			ErrSdl();
+	}
+
+	void signal() noexcept
+	{
+		if (SDL_CondSignal(cond_) == -1)
+			ErrSdl();
+	}
+
+	void broadcast() noexcept
+	{
+		if (SDL_CondBroadcast(cond_) == -1)
+			ErrSdl();
+	}
+
+private:
+	SDL_cond *cond_;
+};
+
+} // namespace devilution
@@ -93,8 +93,8 @@ float VolumeLogToLinear(int logVolume, int logMin, int logMax)
 void SoundSample::Release()
 {
 	stream_ = nullptr;
-	file_data_ = nullptr;
-	file_data_size_ = 0;
+	pcmDecoder_ = nullptr;
+	pcm_ = nullptr;
 }
 
 /**
@@ -124,6 +124,8 @@ int SoundSample::SetChunkStream(std::string filePath, bool isMp3, bool logErrors
 	}
 	file_path_ = std::move(filePath);
 	isMp3_ = isMp3;
+	pcm_ = nullptr;
+	pcmDecoder_ = nullptr;
 	stream_ = CreateStream(handle, isMp3);
 	if (!stream_->open()) {
 		stream_ = nullptr;
@@ -137,18 +139,39 @@ int SoundSample::SetChunkStream(std::string filePath, bool isMp3, bool logErrors
 int SoundSample::SetChunk(ArraySharedPtr<std::uint8_t> fileData, std::size_t dwBytes, bool isMp3)
 {
 	isMp3_ = isMp3;
-	file_data_ = std::move(fileData);
-	file_data_size_ = dwBytes;
-	SDL_RWops *buf = SDL_RWFromConstMem(file_data_.get(), dwBytes);
+	SDL_RWops *buf = SDL_RWFromConstMem(fileData.get(), dwBytes);
 	if (buf == nullptr) {
 		return -1;
 	}
 
-	stream_ = CreateStream(buf, isMp3_);
+	std::shared_ptr<const PcmBuffer> pcm = DecodeToPcm(buf, isMp3_);
+	if (pcm == nullptr) {
+		LogError(LogCategory::Audio, "DecodeToPcm (from SoundSample::SetChunk): {}", SDL_GetError());
+		return -1;
+	}
+
+	return SetPcm(std::move(pcm));
+}
+
+int SoundSample::SetPcm(std::shared_ptr<const PcmBuffer> pcm)
+{
+	if (pcmDecoder_ != nullptr && !stream_->isPlaying()
+	    && pcmDecoder_->getRate() == pcm->rate && pcmDecoder_->getChannels() == pcm->channels) {
+		pcm_ = std::move(pcm);
+		pcmDecoder_->SetBuffer(pcm_);
+		return 0;
+	}
+
+	pcm_ = std::move(pcm);
+	auto decoder = std::make_unique<PcmAulibDecoder>(pcm_);
+	pcmDecoder_ = decoder.get();
+	auto resampler = CreateAulibResampler(pcm_->rate);
+	stream_ = std::make_unique<Aulib::Stream>(/*rwops=*/nullptr, std::move(decoder), std::move(resampler), /*closeRw=*/false);
 	if (!stream_->open()) {
 		stream_ = nullptr;
-		file_data_ = nullptr;
-		LogError(LogCategory::Audio, "Aulib::Stream::open (from SoundSample::SetChunk): {}", SDL_GetError());
+		pcmDecoder_ = nullptr;
+		pcm_ = nullptr;
+		LogError(LogCategory::Audio, "Aulib::Stream::open (from SoundSample::SetPcm): {}", SDL_GetError());
 		return -1;
 	}
 
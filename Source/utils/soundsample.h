@@ -7,6 +7,7 @@
 #include <Aulib/Stream.h>
 
 #include "engine/sound_defs.hpp"
+#include "utils/pcm_aulib_decoder.h"
 #include "utils/stdcompat/shared_ptr_array.hpp"
 
 namespace devilution {
@@ -34,7 +35,7 @@ public:
 	}
 
 	/**
-	 * @brief Sets the sample's WAV, FLAC, or Ogg/Vorbis data.
+	 * @brief Decodes the sample's WAV or MP3 data once and plays it from memory from then on.
 	 * @param fileData Buffer containing the data
 	 * @param dwBytes Length of buffer
 	 * @param isMp3 Whether the data is an MP3
@@ -42,16 +43,30 @@ public:
 	 */
 	int SetChunk(ArraySharedPtr<std::uint8_t> fileData, std::size_t dwBytes, bool isMp3);
 
+	/**
+	 * @brief Plays already decoded data. The stream is reused if it is compatible with the data.
+	 * @return 0 on success, -1 otherwise
+	 */
+	int SetPcm(std::shared_ptr<const PcmBuffer> pcm);
+
 	[[nodiscard]] bool IsStreaming() const
 	{
-		return file_data_ == nullptr;
+		return pcm_ == nullptr;
 	}
 
 	int DuplicateFrom(const SoundSample &other)
 	{
 		if (other.IsStreaming())
 			return SetChunkStream(other.file_path_, other.isMp3_);
-		return SetChunk(other.file_data_, other.file_data_size_, other.isMp3_);
+		return SetPcm(other.pcm_);
+	}
+
+	/**
+	 * @return Size of the decoded data in bytes, 0 for streamed audio
+	 */
+	[[nodiscard]] std::size_t GetMemoryUsage() const
+	{
+		return pcm_ != nullptr ? pcm_->SizeInBytes() : 0;
 	}
 
 	/**
@@ -97,8 +112,9 @@ public:
 
 private:
 	// Non-streaming audio fields:
-	ArraySharedPtr<std::uint8_t> file_data_;
-	std::size_t file_data_size_;
+	std::shared_ptr<const PcmBuffer> pcm_;
+	// Owned by `stream_`.
+	PcmAulibDecoder *pcmDecoder_ = nullptr;
 
 	// Set for streaming audio to allow for duplicating it:
 	std::string file_path_;
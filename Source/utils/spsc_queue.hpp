@@ -0,0 +1,72 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <utility>
+
+namespace devilution {
+
+/**
+ * @brief A fixed capacity lock-free queue with a single producer and a single consumer thread.
+ *
+ * @tparam T element type.
+ * @tparam N capacity, a power of two.
+ */
+template <class T, size_t N>
+class SpscQueue {
+	static_assert(N != 0 && (N & (N - 1)) == 0, "The capacity must be a power of two");
+
+public:
+	/**
+	 * @brief Appends a copy of `value`, must only be called by the producer.
+	 * @return false if the queue is full.
+	 */
+	bool push(const T &value)
+	{
+		const size_t tail = tail_.load(std::memory_order_relaxed);
+		if (tail - head_.load(std::memory_order_acquire) == N)
+			return false;
+		elements_[tail % N] = value;
+		tail_.store(tail + 1, std::memory_order_release);
+		return true;
+	}
+
+	/**
+	 * @brief Moves the oldest element to `value`, must only be called by the consumer.
+	 * @return false if the queue is empty.
+	 */
+	bool pop(T &value)
+	{
+		const size_t head = head_.load(std::memory_order_relaxed);
+		if (tail_.load(std::memory_order_acquire) == head)
+			return false;
+		value = std::move(elements_[head % N]);
+		head_.store(head + 1, std::memory_order_release);
+		return true;
+	}
+
+	/**
+	 * @brief Number of queued elements.
+	 *
+	 * Only exact while the other thread is idle: for the producer the queue holds at most this many elements,
+	 * for the consumer at least this many.
+	 */
+	[[nodiscard]] size_t size() const
+	{
+		return tail_.load(std::memory_order_acquire) - head_.load(std::memory_order_acquire);
+	}
+
+	[[nodiscard]] static constexpr size_t capacity()
+	{
+		return N;
+	}
+
+private:
+	T elements_[N];
+	// The indices only ever increase and wrap around together with size_t, so `tail_ - head_` is always the size.
+	// They are on separate cache lines so that the two threads do not invalidate each other's line on every call.
+	alignas(64) std::atomic<size_t> head_ { 0 };
+	alignas(64) std::atomic<size_t> tail_ { 0 };
+};
+
+} // namespace devilution
@@ -0,0 +1,73 @@
+#include "utils/worker_pool.hpp"
+
+namespace devilution {
+
+WorkerPool::WorkerPool(unsigned numWorkers)
+{
+	threads_.reserve(numWorkers);
+	for (unsigned i = 0; i < numWorkers; i++)
+		threads_.emplace_back(WorkerMain, this);
+}
+
+WorkerPool::~WorkerPool()
+{
+	mutex_.lock();
+	quit_ = true;
+	workAvailable_.broadcast();
+	mutex_.unlock();
+	for (SdlThread &thread : threads_)
+		thread.join();
+}
+
+void WorkerPool::parallelFor(unsigned count, const std::function<void(unsigned)> &task)
+{
+	if (threads_.empty() || count <= 1) {
+		for (unsigned i = 0; i < count; i++)
+			task(i);
+		return;
+	}
+
+	mutex_.lock();
+	task_ = &task;
+	count_ = count;
+	next_ = 0;
+	pending_ = count;
+	workAvailable_.broadcast();
+	runTasks();
+	while (pending_ != 0)
+		workDone_.wait(mutex_);
+	task_ = nullptr;
+	count_ = 0;
+	next_ = 0;
+	mutex_.unlock();
+}
+
+void WorkerPool::runTasks()
+{
+	while (next_ < count_) {
+		const unsigned index = next_++;
+		const std::function<void(unsigned)> &task = *task_;
+		mutex_.unlock();
+		task(index);
+		mutex_.lock();
+		if (--pending_ == 0)
+			workDone_.broadcast();
+	}
+}
+
+int SDLCALL WorkerPool::WorkerMain(void *data)
+{
+	auto &pool = *static_cast<WorkerPool *>(data);
+	pool.mutex_.lock();
+	while (true) {
+		while (!pool.quit_ && pool.next_ >= pool.count_)
+			pool.workAvailable_.wait(pool.mutex_);
+		if (pool.quit_)
+			break;
+		pool.runTasks();
+	}
+	pool.mutex_.unlock();
+	return 0;
+}
+
+} // namespace devilution
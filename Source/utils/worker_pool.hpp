@@ -0,0 +1,62 @@
+#pragma once
+
+#include <functional>
+#include <vector>
+
+#include "utils/sdl_cond.h"
+#include "utils/sdl_mutex.h"
+#include "utils/sdl_thread.h"
+
+namespace devilution {
+
+/**
+ * @brief A fixed set of threads that split up the work of a single job.
+ *
+ * Only one job runs at a time, the thread that submits the job takes part in it.
+ */
+class WorkerPool {
+public:
+	/**
+	 * @param numWorkers Number of threads to start in addition to the calling thread.
+	 */
+	explicit WorkerPool(unsigned numWorkers);
+	~WorkerPool();
+
+	WorkerPool(const WorkerPool &) = delete;
+	WorkerPool &operator=(const WorkerPool &) = delete;
+
+	/**
+	 * @brief Number of threads started by the pool, not counting the calling thread.
+	 */
+	[[nodiscard]] unsigned size() const
+	{
+		return static_cast<unsigned>(threads_.size());
+	}
+
+	/**
+	 * @brief Calls `task(i)` for every `i` in `[0, count)` and returns once all calls have finished.
+	 *
+	 * The calls are distributed over the pool's threads and the calling thread, in no particular order.
+	 */
+	void parallelFor(unsigned count, const std::function<void(unsigned)> &task);
+
+private:
+	static int SDLCALL WorkerMain(void *data);
+
+	/**
+	 * @brief Runs tasks of the current job until none are left to claim, expects `mutex_` to be locked.
+	 */
+	void runTasks();
+
+	SdlMutex mutex_;
+	SdlCond workAvailable_;
+	SdlCond workDone_;
+	const std::function<void(unsigned)> *task_ = nullptr;
+	unsigned count_ = 0;
+	unsigned next_ = 0;
+	unsigned pending_ = 0;
+	bool quit_ = false;
+	std::vector<SdlThread> threads_;
+};
+
+} // namespace devilution
@@ -0,0 +1,153 @@
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "engine/clx_cache.hpp"
+#include "utils/endian.hpp"
+#include "utils/paths.h"
+
+using namespace devilution;
+
+namespace {
+
+/**
+ * @brief A CLX sprite list with `numSprites` sprites of `spriteSize` bytes each.
+ */
+std::vector<uint8_t> MakeClxList(uint32_t numSprites, uint32_t spriteSize)
+{
+	const uint32_t headerSize = 4 + 4 * (numSprites + 1);
+	std::vector<uint8_t> data(headerSize + numSprites * spriteSize);
+	WriteLE32(data.data(), numSprites);
+	for (uint32_t i = 0; i <= numSprites; i++)
+		WriteLE32(&data[4 + 4 * i], headerSize + i * spriteSize);
+	for (size_t i = headerSize; i < data.size(); i++)
+		data[i] = static_cast<uint8_t>(i * 7);
+	return data;
+}
+
+class ClxCacheTest : public ::testing::Test {
+protected:
+	void SetUp() override
+	{
+		dir_ = std::filesystem::temp_directory_path() / "clx_cache_test";
+		std::filesystem::remove_all(dir_);
+		std::filesystem::create_directories(dir_);
+		paths::SetPrefPath(dir_.string());
+	}
+
+	void TearDown() override
+	{
+		std::filesystem::remove_all(dir_);
+	}
+
+	std::filesystem::path EntryPath(const ClxCacheKey &key)
+	{
+		char name[32];
+		std::snprintf(name, sizeof(name), "%016llx.clx", static_cast<unsigned long long>(key.entry));
+		return dir_ / "cache" / name;
+	}
+
+	std::filesystem::path dir_;
+};
+
+TEST_F(ClxCacheTest, MissingEntry)
+{
+	EXPECT_FALSE(LoadCachedClx(ClxCacheKey { 1, 2 }));
+}
+
+TEST_F(ClxCacheTest, ListRoundTrip)
+{
+	const std::vector<uint8_t> list = MakeClxList(3, 10);
+	const ClxCacheKey key { 0x1234, 0x5678 };
+	StoreCachedClx(key, ClxSpriteListOrSheet { list.data(), 0 });
+
+	OptionalOwnedClxSpriteListOrSheet cached = LoadCachedClx(key);
+	ASSERT_TRUE(cached);
+	ASSERT_FALSE(cached->isSheet());
+	EXPECT_EQ(memcmp(cached->list().data(), list.data(), list.size()), 0);
+}
+
+TEST_F(ClxCacheTest, SheetRoundTrip)
+{
+	const std::vector<uint8_t> first = MakeClxList(2, 5);
+	const std::vector<uint8_t> second = MakeClxList(4, 3);
+	std::vector<uint8_t> sheet(8);
+	WriteLE32(&sheet[0], static_cast<uint32_t>(sheet.size()));
+	WriteLE32(&sheet[4], static_cast<uint32_t>(sheet.size() + first.size()));
+	sheet.insert(sheet.end(), first.begin(), first.end());
+	sheet.insert(sheet.end(), second.begin(), second.end());
+	const ClxCacheKey key { 1, 1 };
+	StoreCachedClx(key, ClxSpriteListOrSheet { sheet.data(), 2 });
+
+	OptionalOwnedClxSpriteListOrSheet cached = LoadCachedClx(key);
+	ASSERT_TRUE(cached);
+	ASSERT_TRUE(cached->isSheet());
+	EXPECT_EQ(cached->sheet().numLists(), 2);
+	EXPECT_EQ(memcmp(cached->sheet().data(), sheet.data(), sheet.size()), 0);
+}
+
+TEST_F(ClxCacheTest, PaletteRoundTrip)
+{
+	const std::vector<uint8_t> list = MakeClxList(1, 16);
+	SDL_Color palette[256];
+	for (int i = 0; i < 256; i++)
+		palette[i] = SDL_Color { static_cast<Uint8>(i), static_cast<Uint8>(255 - i), static_cast<Uint8>(i / 2), 255 };
+	const ClxCacheKey key { 2, 2 };
+	StoreCachedClx(key, ClxSpriteListOrSheet { list.data(), 0 }, palette);
+
+	SDL_Color loaded[256] = {};
+	ASSERT_TRUE(LoadCachedClx(key, loaded));
+	for (int i = 0; i < 256; i++) {
+		EXPECT_EQ(loaded[i].r, palette[i].r);
+		EXPECT_EQ(loaded[i].g, palette[i].g);
+		EXPECT_EQ(loaded[i].b, palette[i].b);
+	}
+}
+
+TEST_F(ClxCacheTest, RejectsMissingPalette)
+{
+	const std::vector<uint8_t> list = MakeClxList(1, 16);
+	const ClxCacheKey key { 3, 3 };
+	StoreCachedClx(key, ClxSpriteListOrSheet { list.data(), 0 });
+
+	SDL_Color loaded[256];
+	EXPECT_FALSE(LoadCachedClx(key, loaded));
+}
+
+TEST_F(ClxCacheTest, RejectsStaleSource)
+{
+	const std::vector<uint8_t> list = MakeClxList(3, 10);
+	StoreCachedClx(ClxCacheKey { 4, 100 }, ClxSpriteListOrSheet { list.data(), 0 });
+
+	EXPECT_FALSE(LoadCachedClx(ClxCacheKey { 4, 101 }));
+	EXPECT_TRUE(LoadCachedClx(ClxCacheKey { 4, 100 }));
+}
+
+TEST_F(ClxCacheTest, RejectsDamagedEntry)
+{
+	const std::vector<uint8_t> list = MakeClxList(3, 10);
+	const ClxCacheKey key { 5, 5 };
+	StoreCachedClx(key, ClxSpriteListOrSheet { list.data(), 0 });
+
+	const std::filesystem::path path = EntryPath(key);
+	ASSERT_TRUE(std::filesystem::exists(path));
+	{
+		FILE *file = std::fopen(path.string().c_str(), "r+b");
+		ASSERT_NE(file, nullptr);
+		std::fseek(file, -1, SEEK_END);
+		std::fputc(0xFF, file);
+		std::fclose(file);
+	}
+	EXPECT_FALSE(LoadCachedClx(key));
+
+	std::filesystem::resize_file(path, std::filesystem::file_size(path) - 4);
+	EXPECT_FALSE(LoadCachedClx(key));
+}
+
+} // namespace
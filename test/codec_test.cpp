@@ -1,3 +1,8 @@
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <vector>
+
 #include <gtest/gtest.h>
 
 #include "codec.h"
@@ -13,3 +18,63 @@ TEST(Codec, codec_get_encoded_len_eq)
 {
 	EXPECT_EQ(codec_get_encoded_len(128), 136);
 }
+
+namespace {
+
+// Output of codec_encode for the bytes 0..49 with the single player password.
+constexpr std::array<uint8_t, 72> EncodedSequence {
+	0x62, 0x6C, 0xF6, 0x28, 0x4A, 0xE1, 0x25, 0x93, 0xDA, 0xB7, 0xC1, 0x9C,
+	0x15, 0x18, 0x41, 0x63, 0x26, 0x46, 0x01, 0x30, 0x76, 0x78, 0xE2, 0x3C,
+	0x56, 0xFD, 0x39, 0x8F, 0xCE, 0xA3, 0xD5, 0x88, 0x39, 0x34, 0x6D, 0x4F,
+	0x12, 0x72, 0x35, 0x04, 0x4A, 0x44, 0xDE, 0x00, 0x62, 0xC9, 0x0D, 0xBB,
+	0xE2, 0x8F, 0xCB, 0x97, 0x19, 0x15, 0x4F, 0x6C, 0x36, 0x57, 0x13, 0x23,
+	0x62, 0x6D, 0xF4, 0x2B, 0x4B, 0x00, 0xC7, 0xEE, 0x00, 0x32, 0x00, 0x00
+};
+
+std::vector<byte> MakeSequence(std::size_t size)
+{
+	std::vector<byte> data(codec_get_encoded_len(size));
+	for (std::size_t i = 0; i < size; i++)
+		data[i] = static_cast<byte>(i);
+	return data;
+}
+
+} // namespace
+
+TEST(Codec, codec_encode)
+{
+	std::vector<byte> data = MakeSequence(50);
+	codec_encode(data.data(), 50, data.size(), "xrgyrkj1");
+	ASSERT_EQ(data.size(), EncodedSequence.size());
+	for (std::size_t i = 0; i < data.size(); i++)
+		EXPECT_EQ(static_cast<uint8_t>(data[i]), EncodedSequence[i]) << "at byte " << i;
+}
+
+TEST(Codec, codec_decode)
+{
+	std::vector<byte> data(EncodedSequence.size());
+	for (std::size_t i = 0; i < data.size(); i++)
+		data[i] = static_cast<byte>(EncodedSequence[i]);
+	ASSERT_EQ(codec_decode(data.data(), data.size(), "xrgyrkj1"), 50);
+	for (std::size_t i = 0; i < 50; i++)
+		EXPECT_EQ(static_cast<uint8_t>(data[i]), i);
+}
+
+TEST(Codec, codec_decode_wrong_password)
+{
+	std::vector<byte> data = MakeSequence(50);
+	codec_encode(data.data(), 50, data.size(), "xrgyrkj1");
+	EXPECT_EQ(codec_decode(data.data(), data.size(), "szqnlsk1"), 0);
+}
+
+TEST(Codec, codec_round_trip)
+{
+	for (std::size_t size : { 1, 63, 64, 65, 128, 256 * 1024 }) {
+		std::vector<byte> data = MakeSequence(size);
+		const std::vector<byte> original = data;
+		codec_encode(data.data(), size, data.size(), "szqnlsk1");
+		EXPECT_NE(data, original);
+		ASSERT_EQ(codec_decode(data.data(), data.size(), "szqnlsk1"), size);
+		EXPECT_TRUE(std::equal(original.begin(), original.begin() + size, data.begin())) << "size " << size;
+	}
+}
@@ -0,0 +1,166 @@
+#include <gtest/gtest.h>
+
+#include <array>
+#include <vector>
+
+#include "engine/render/draw_list.hpp"
+#include "lighting.h"
+#include "utils/surface_to_clx.hpp"
+#include "utils/worker_pool.hpp"
+
+namespace devilution {
+namespace {
+
+// A CLX frame header describing an 8x4 sprite without any pixel data.
+constexpr std::array<uint8_t, 10> SpriteData { 10, 0, 8, 0, 4, 0, 0, 0, 0, 0 };
+
+ClxSprite TestSprite()
+{
+	return ClxSprite { SpriteData.data(), static_cast<uint32_t>(SpriteData.size()) };
+}
+
+TEST(DrawListTest, SortKeepsTileOrder)
+{
+	DrawList drawList;
+	drawList.nextTile();
+	drawList.addSprite(DrawLayer::Special, BlitMode::Plain, { 1, 0 }, TestSprite());
+	drawList.nextTile();
+	drawList.addTile({ 2, 0 }, LevelCelBlock { 0x1001 }, MaskType::Solid, 0);
+	drawList.addSprite(DrawLayer::Item, BlitMode::Plain, { 3, 0 }, TestSprite());
+	drawList.sort();
+
+	const std::vector<DrawCommand> &commands = drawList.commands();
+	ASSERT_EQ(commands.size(), 3);
+	EXPECT_EQ(commands[0].position.x, 1);
+	EXPECT_EQ(commands[1].position.x, 2);
+	EXPECT_EQ(commands[2].position.x, 3);
+}
+
+TEST(DrawListTest, SortLayersWithinTile)
+{
+	DrawList drawList;
+	drawList.nextTile();
+	drawList.addSprite(DrawLayer::Item, BlitMode::Plain, { 1, 0 }, TestSprite());
+	drawList.addOutline(DrawLayer::Corpse, 165, { 2, 0 }, TestSprite());
+	drawList.addSprite(DrawLayer::Corpse, BlitMode::Light, { 3, 0 }, TestSprite());
+	drawList.addTile({ 4, 0 }, LevelCelBlock { 0x1001 }, MaskType::Solid, 0);
+	drawList.sort();
+
+	const std::vector<DrawCommand> &commands = drawList.commands();
+	ASSERT_EQ(commands.size(), 4);
+	EXPECT_EQ(commands[0].mode, BlitMode::Tile);
+	EXPECT_EQ(commands[1].mode, BlitMode::Outline);
+	EXPECT_EQ(commands[2].mode, BlitMode::Light);
+	EXPECT_EQ(commands[3].mode, BlitMode::Plain);
+}
+
+TEST(DrawListTest, TileKeepsLevelCelBlock)
+{
+	DrawList drawList;
+	drawList.addTile({ 0, 0 }, LevelCelBlock { 0x3123 }, MaskType::LeftFoliage, 7);
+
+	const DrawCommand &command = drawList.commands()[0];
+	const LevelCelBlock levelCelBlock { command.levelCelBlock };
+	EXPECT_EQ(levelCelBlock.type(), TileType::RightTriangle);
+	EXPECT_EQ(levelCelBlock.frame(), 0x123);
+	EXPECT_EQ(static_cast<MaskType>(command.param), MaskType::LeftFoliage);
+	EXPECT_EQ(command.lightTableIndex, 7);
+}
+
+TEST(DrawListTest, Bounds)
+{
+	DrawList drawList;
+	drawList.addSprite(DrawLayer::Player, BlitMode::Plain, { 10, 20 }, TestSprite());
+	drawList.addOutline(DrawLayer::Player, 165, { 10, 20 }, TestSprite());
+	drawList.addTile({ 10, 40 }, LevelCelBlock { 0x1001 }, MaskType::Solid, 0);
+	drawList.addBlackTile({ 10, 60 });
+
+	const std::vector<DrawCommand> &commands = drawList.commands();
+	const Rectangle sprite = commands[0].bounds();
+	EXPECT_EQ(sprite.position, Point(10, 17));
+	EXPECT_EQ(sprite.size, Size(8, 4));
+	const Rectangle outline = commands[1].bounds();
+	EXPECT_EQ(outline.position, Point(9, 16));
+	EXPECT_EQ(outline.size, Size(10, 6));
+	const Rectangle tile = commands[2].bounds();
+	EXPECT_EQ(tile.position, Point(10, 40 - TILE_HEIGHT + 1));
+	EXPECT_EQ(tile.size, Size(TILE_WIDTH / 2, TILE_HEIGHT));
+	const Rectangle blackTile = commands[3].bounds();
+	EXPECT_EQ(blackTile.position, Point(10, 60 - TILE_HEIGHT + 1));
+	EXPECT_EQ(blackTile.size, Size(TILE_WIDTH, TILE_HEIGHT));
+}
+
+TEST(DrawListTest, SortKeepsFloorFirst)
+{
+	DrawList drawList;
+	drawList.addBlackTile({ 1, 0 });
+	drawList.addTile({ 2, 0 }, LevelCelBlock { 0x1001 }, MaskType::Solid, 0);
+	drawList.nextTile();
+	drawList.addSprite(DrawLayer::Corpse, BlitMode::Plain, { 3, 0 }, TestSprite());
+	drawList.sort();
+
+	const std::vector<DrawCommand> &commands = drawList.commands();
+	ASSERT_EQ(commands.size(), 3);
+	EXPECT_EQ(commands[0].mode, BlitMode::BlackTile);
+	EXPECT_EQ(commands[1].position.x, 2);
+	EXPECT_EQ(commands[2].position.x, 3);
+}
+
+TEST(DrawListTest, ClearResetsDepth)
+{
+	DrawList drawList;
+	drawList.nextTile();
+	drawList.addSprite(DrawLayer::Item, BlitMode::Plain, { 0, 0 }, TestSprite());
+	drawList.clear();
+	EXPECT_TRUE(drawList.commands().empty());
+	drawList.addSprite(DrawLayer::Item, BlitMode::Plain, { 0, 0 }, TestSprite());
+	EXPECT_EQ(drawList.commands()[0].depth, static_cast<uint32_t>(DrawLayer::Item));
+}
+
+TEST(DrawListTest, BandedSubmitMatchesSingleSubmit)
+{
+	for (size_t i = 0; i < LightTables.size(); i++) {
+		for (size_t j = 0; j < LightTables[i].size(); j++)
+			LightTables[i][j] = static_cast<uint8_t>(j + i);
+	}
+
+	OwnedSurface spriteSurface { 23, 2 * 17 };
+	for (int y = 0; y < spriteSurface.h(); y++) {
+		for (int x = 0; x < spriteSurface.w(); x++)
+			spriteSurface[Point(x, y)] = static_cast<uint8_t>((x * 7 + y * 13) % 5 == 0 ? 1 : (x + y) % 256);
+	}
+	const OwnedClxSpriteList sprites = SurfaceToClx(spriteSurface, 2, 1);
+	const std::array<uint8_t, 256> trn = LightTables[3];
+
+	DrawList drawList;
+	for (int i = 0; i < 64; i++) {
+		drawList.nextTile();
+		const Point position { (i * 37) % 160 - 10, (i * 53) % 140 };
+		const ClxSprite sprite = sprites[i % 2];
+		LightTableIndex = i % 4;
+		drawList.addOutline(DrawLayer::Monster, 200, position, sprite);
+		drawList.addSprite(DrawLayer::Monster, static_cast<BlitMode>(1 + i % 4), position, sprite, trn.data());
+	}
+	LightTableIndex = 0;
+	drawList.sort();
+
+	OwnedSurface single { 150, 120 };
+	drawList.submit(single);
+
+	OwnedSurface banded { 150, 120 };
+	constexpr int NumBands = 4;
+	constexpr int BandHeight = 120 / NumBands;
+	WorkerPool workers { NumBands - 1 };
+	workers.parallelFor(NumBands, [&](unsigned band) {
+		const int top = static_cast<int>(band) * BandHeight;
+		drawList.submit(banded.subregionY(top, BandHeight), { 0, -top });
+	});
+
+	for (int y = 0; y < single.h(); y++) {
+		for (int x = 0; x < single.w(); x++)
+			ASSERT_EQ(single[Point(x, y)], banded[Point(x, y)]) << "at " << x << ", " << y;
+	}
+}
+
+} // namespace
+} // namespace devilution
@@ -0,0 +1,107 @@
+#include <gtest/gtest.h>
+
+#include <cstring>
+#include <vector>
+
+#include "engine/render/dun_render.hpp"
+#include "init.h"
+#include "levels/gendung.h"
+#include "lighting.h"
+
+namespace devilution {
+namespace {
+
+constexpr int TileWidth = TILE_WIDTH / 2;
+constexpr int TileHeight = TILE_HEIGHT;
+
+/**
+ * @brief Builds a level CEL file with a square (frame 1) and a transparent square (frame 2).
+ */
+std::vector<uint8_t> BuildTestCel(std::vector<uint8_t> &transparentSquare)
+{
+	std::vector<uint8_t> square(TileWidth * TileHeight);
+	for (size_t i = 0; i < square.size(); i++)
+		square[i] = static_cast<uint8_t>(i * 7);
+
+	// Every line is an opaque run of 20 pixels followed by 12 transparent pixels.
+	transparentSquare.clear();
+	for (int y = 0; y < TileHeight; y++) {
+		transparentSquare.push_back(20);
+		for (int x = 0; x < 20; x++)
+			transparentSquare.push_back(static_cast<uint8_t>(x * 5 + y));
+		transparentSquare.push_back(static_cast<uint8_t>(-12));
+	}
+
+	const uint32_t headerSize = 4 * 4;
+	std::vector<uint8_t> cel(headerSize);
+	const uint32_t offsets[] = { 2, headerSize, static_cast<uint32_t>(headerSize + square.size()), static_cast<uint32_t>(headerSize + square.size() + transparentSquare.size()) };
+	memcpy(cel.data(), offsets, sizeof(offsets));
+	cel.insert(cel.end(), square.begin(), square.end());
+	cel.insert(cel.end(), transparentSquare.begin(), transparentSquare.end());
+	return cel;
+}
+
+void RenderAndCompare(uint8_t lightTableIndex)
+{
+	std::vector<uint8_t> transparentSquare;
+	const std::vector<uint8_t> cel = BuildTestCel(transparentSquare);
+	pDungeonCels = std::make_unique<byte[]>(cel.size());
+	memcpy(pDungeonCels.get(), cel.data(), cel.size());
+
+	OwnedSurface out { TileWidth * 2, TileHeight };
+	// Render twice, the second time from the cache.
+	for (int pass = 0; pass < 2; pass++) {
+		BeginTileLightCacheFrame();
+		RenderTile(out, { 0, TileHeight - 1 }, LevelCelBlock { 0x0001 }, MaskType::Solid, lightTableIndex);
+		RenderTile(out, { TileWidth, TileHeight - 1 }, LevelCelBlock { 0x1002 }, MaskType::Solid, lightTableIndex);
+
+		const uint8_t *tbl = LightTables[lightTableIndex].data();
+		for (int y = 0; y < TileHeight; y++) {
+			const int line = TileHeight - 1 - y;
+			for (int x = 0; x < TileWidth; x++)
+				ASSERT_EQ(out[Point(x, line)], tbl[static_cast<uint8_t>((y * TileWidth + x) * 7)]) << "square at " << x << ", " << y;
+			for (int x = 0; x < 20; x++)
+				ASSERT_EQ(out[Point(TileWidth + x, line)], tbl[static_cast<uint8_t>(x * 5 + y)]) << "transparent square at " << x << ", " << y;
+		}
+	}
+	pDungeonCels = nullptr;
+}
+
+class DunRenderTest : public ::testing::Test {
+protected:
+	void SetUp() override
+	{
+		for (size_t i = 0; i < LightTables.size(); i++) {
+			for (size_t j = 0; j < LightTables[i].size(); j++)
+				LightTables[i][j] = static_cast<uint8_t>(j / (i + 1));
+		}
+		ClearTileLightCache();
+	}
+};
+
+TEST_F(DunRenderTest, FullyLit)
+{
+	RenderAndCompare(0);
+}
+
+TEST_F(DunRenderTest, PartiallyLit)
+{
+	RenderAndCompare(3);
+}
+
+TEST_F(DunRenderTest, PartiallyLitAfterMakeLightTable)
+{
+	LoadCoreArchives();
+	LoadGameArchives();
+	// MakeLightTable loads tables from the game data.
+	if (!HaveSpawn() && !HaveDiabdat())
+		GTEST_SKIP() << "MakeLightTable needs spawn.mpq or diabdat.mpq";
+
+	RenderAndCompare(5);
+	leveltype = DTYPE_CATHEDRAL;
+	MakeLightTable();
+	RenderAndCompare(5);
+}
+
+} // namespace
+} // namespace devilution
@@ -0,0 +1,126 @@
+#include <cstdint>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "engine/frame_pacing.hpp"
+
+using namespace devilution;
+
+namespace {
+
+constexpr int64_t Period = 16667;
+
+int64_t FakeTime;
+/** @brief How much later than requested a sleep ends. */
+int64_t FakeSleepOvershoot;
+int FakeSleeps;
+
+int64_t FakeNow()
+{
+	// Every reading takes a little time, so that spinning advances the clock.
+	return FakeTime++;
+}
+
+void FakeSleep(uint32_t milliseconds)
+{
+	FakeTime += milliseconds * 1000 + FakeSleepOvershoot;
+	FakeSleeps++;
+}
+
+class FramePacingTest : public ::testing::Test {
+protected:
+	void SetUp() override
+	{
+		FakeTime = 1000000;
+		FakeSleepOvershoot = 0;
+		FakeSleeps = 0;
+		pacer_.setPeriod(Period);
+	}
+
+	/**
+	 * @brief Runs frames that take `work` microseconds and returns the time each one finished presenting.
+	 */
+	std::vector<int64_t> RunFrames(int count, int64_t work)
+	{
+		std::vector<int64_t> presents;
+		for (int i = 0; i < count; i++) {
+			pacer_.beginFrame();
+			FakeTime += work;
+			pacer_.beginPresent();
+			FakeTime += 100;
+			pacer_.endPresent();
+			presents.push_back(FakeTime);
+			pacer_.endFrame();
+		}
+		return presents;
+	}
+
+	FramePacer pacer_ { FramePacer::Clock { FakeNow, FakeSleep } };
+};
+
+void ExpectSpacedByPeriod(const std::vector<int64_t> &presents, size_t first)
+{
+	for (size_t i = first; i < presents.size(); i++) {
+		EXPECT_NEAR(presents[i] - presents[i - 1], Period, 20) << "between frames " << i - 1 << " and " << i;
+	}
+}
+
+TEST_F(FramePacingTest, SpacesFramesByPeriod)
+{
+	const std::vector<int64_t> presents = RunFrames(20, 5000);
+	// The schedule starts when the first frame ends.
+	ExpectSpacedByPeriod(presents, 2);
+	EXPECT_GT(FakeSleeps, 0);
+}
+
+TEST_F(FramePacingTest, AdaptsToLateWakeUps)
+{
+	FakeSleepOvershoot = 1500;
+	const std::vector<int64_t> presents = RunFrames(40, 5000);
+	// The first sleeps end late, after that they end early enough to spin up to the deadline.
+	ExpectSpacedByPeriod(presents, 5);
+}
+
+TEST_F(FramePacingTest, StartsOverAfterSlowFrame)
+{
+	RunFrames(5, 5000);
+	RunFrames(1, 100000);
+	const std::vector<int64_t> presents = RunFrames(5, 5000);
+	// No frames are rushed out to catch up with the missed deadlines.
+	ExpectSpacedByPeriod(presents, 1);
+}
+
+TEST_F(FramePacingTest, LowLatencyWaitsBeforeFrame)
+{
+	pacer_.setLowLatency(true);
+	constexpr int64_t Work = 5000;
+	std::vector<int64_t> frameStarts;
+	std::vector<int64_t> presents;
+	for (int i = 0; i < 30; i++) {
+		pacer_.beginFrame();
+		frameStarts.push_back(FakeTime);
+		FakeTime += Work;
+		pacer_.beginPresent();
+		FakeTime += 100;
+		pacer_.endPresent();
+		presents.push_back(FakeTime);
+		const int64_t beforeEnd = FakeTime;
+		pacer_.endFrame();
+		EXPECT_LT(FakeTime - beforeEnd, 10) << "frame " << i << " waited after presenting";
+	}
+
+	ExpectSpacedByPeriod(presents, 5);
+	// Input is read just before the frame, rather than a whole period before its present.
+	EXPECT_LT(presents.back() - frameStarts.back(), Work + 200);
+	EXPECT_GE(pacer_.predictedFrameCost(), Work + 100);
+}
+
+TEST_F(FramePacingTest, MeasuresPresentDuration)
+{
+	RunFrames(3, 1000);
+	EXPECT_NEAR(pacer_.takePresentDuration(), 300, 10);
+	EXPECT_EQ(pacer_.takePresentDuration(), 0);
+}
+
+} // namespace
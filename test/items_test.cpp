@@ -0,0 +1,186 @@
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <cstring>
+#include <thread>
+
+#include "items.h"
+#include "player.h"
+
+namespace devilution {
+namespace {
+
+class ItemsTest : public ::testing::Test {
+public:
+	void SetUp() override
+	{
+		Players.resize(1);
+		MyPlayer = &Players[0];
+		gbIsMultiplayer = false;
+		gbIsSpawn = false;
+	}
+};
+
+void HashBytes(uint32_t &hash, const void *data, size_t size)
+{
+	const auto *bytes = static_cast<const unsigned char *>(data);
+	for (size_t i = 0; i < size; i++) {
+		hash ^= bytes[i];
+		hash *= 16777619U;
+	}
+}
+
+template <typename T>
+void HashValue(uint32_t &hash, T value)
+{
+	HashBytes(hash, &value, sizeof(value));
+}
+
+/**
+ * @brief Generates items for many seeds and folds what the affix and unique rolls decide into a hash.
+ *
+ * Names are left out as they depend on the loaded font and translation.
+ */
+uint32_t HashGeneratedItems(bool hellfire)
+{
+	std::memset(UniqueItemFlags, 0, sizeof(UniqueItemFlags));
+
+	uint32_t hash = 2166136261U;
+	for (int idx = 0; AllItemsList[idx].iName != nullptr; idx++) {
+		if (idx == IDI_GOLD || AllItemsList[idx].iRnd == IDROP_NEVER)
+			continue;
+		for (int seed = 0; seed < 200; seed++) {
+			uint16_t createInfo = 1 + seed % 60;
+			createInfo |= seed % 5 == 0 ? CF_UPER15 : CF_UPER1;
+			if (seed % 7 == 0)
+				createInfo |= CF_ONLYGOOD;
+			Item item {};
+			RecreateItem(*MyPlayer, item, static_cast<_item_indexes>(idx), createInfo, seed * 7919 + idx, 0, hellfire);
+			HashValue(hash, item._iMagical);
+			HashValue(hash, item._iPrePower);
+			HashValue(hash, item._iSufPower);
+			HashValue(hash, item._iUid);
+			HashValue(hash, item._ivalue);
+			HashValue(hash, item._iPLDam);
+			HashValue(hash, item._iPLToHit);
+			HashValue(hash, item._iPLAC);
+			HashValue(hash, item._iMaxCharges);
+			HashValue(hash, item._iSpell);
+			HashValue(hash, item._iMinStr);
+		}
+	}
+	return hash;
+}
+
+TEST_F(ItemsTest, AffixRollsMatchReference_diablo)
+{
+	EXPECT_EQ(HashGeneratedItems(false), 3182237964U);
+}
+
+TEST_F(ItemsTest, AffixRollsMatchReference_hellfire)
+{
+	EXPECT_EQ(HashGeneratedItems(true), 764652063U);
+}
+
+TEST_F(ItemsTest, AffixRollsMatchReferenceOnSeveralThreads)
+{
+	// Fills the font caches that naming the items uses, which are shared between threads.
+	HashGeneratedItems(false);
+
+	// `gbIsHellfire` is shared as well, so all threads generate items for the same game.
+	for (const bool hellfire : { false, true }) {
+		gbIsHellfire = hellfire;
+		uint32_t hashes[2] = {};
+		std::thread first([&]() { hashes[0] = HashGeneratedItems(hellfire); });
+		std::thread second([&]() { hashes[1] = HashGeneratedItems(hellfire); });
+		first.join();
+		second.join();
+		gbIsHellfire = false;
+
+		const uint32_t expected = hellfire ? 764652063U : 3182237964U;
+		EXPECT_EQ(hashes[0], expected);
+		EXPECT_EQ(hashes[1], expected);
+	}
+}
+
+TEST_F(ItemsTest, StatBonusesOfUnidentifiedItem)
+{
+	Item item {};
+	item._itype = ItemType::Sword;
+	item._iStatFlag = true;
+	item._iMinDam = 2;
+	item._iMaxDam = 10;
+	item._iMagical = ITEM_QUALITY_MAGIC;
+	item._iPLStr = 5;
+	item._iPLLight = 2;
+
+	ItemStatBonuses bonuses = GetItemStatBonuses(item);
+	EXPECT_EQ(bonuses.minDamage, 2);
+	EXPECT_EQ(bonuses.maxDamage, 10);
+	EXPECT_EQ(bonuses.strength, 0);
+	EXPECT_EQ(bonuses.lightRadius, 0);
+
+	item._iIdentified = true;
+	bonuses = GetItemStatBonuses(item);
+	EXPECT_EQ(bonuses.strength, 5);
+	EXPECT_EQ(bonuses.lightRadius, 2);
+
+	item._iStatFlag = false;
+	bonuses = GetItemStatBonuses(item);
+	EXPECT_EQ(bonuses.minDamage, 0);
+	EXPECT_EQ(bonuses.strength, 0);
+}
+
+TEST_F(ItemsTest, StatBonusesAccumulate)
+{
+	ItemStatBonuses bonuses;
+	ItemStatBonuses ring;
+	ring.magicResist = 10;
+	ring.flags = ItemSpecialEffect::FireArrows;
+	ItemStatBonuses amulet;
+	amulet.magicResist = 15;
+	amulet.flags = ItemSpecialEffect::ZeroResistance;
+	amulet.spells = 4;
+
+	bonuses += ring;
+	bonuses += amulet;
+	EXPECT_EQ(bonuses.magicResist, 25);
+	EXPECT_EQ(bonuses.flags, ItemSpecialEffect::FireArrows | ItemSpecialEffect::ZeroResistance);
+	EXPECT_EQ(bonuses.spells, 4);
+}
+
+TEST_F(ItemsTest, StatBonusesCacheFollowsItemChanges)
+{
+	Item item {};
+	item._itype = ItemType::Sword;
+	item._iStatFlag = true;
+	item._iMinDam = 2;
+	item._iMaxDam = 10;
+	item._iMagical = ITEM_QUALITY_MAGIC;
+	item._iPLStr = 5;
+
+	ItemStatBonusesCache cache;
+	EXPECT_EQ(cache.get(item), GetItemStatBonuses(item));
+
+	item._iIdentified = true;
+	EXPECT_EQ(cache.get(item).strength, 5);
+
+	// Oils change the damage in place.
+	item._iMaxDam = 12;
+	EXPECT_EQ(cache.get(item).maxDamage, 12);
+
+	// Weapon decay lowers the damage bonus in place.
+	item._iPLDam = 50;
+	EXPECT_EQ(cache.get(item).bonusDamage, 50);
+	item._iPLDam -= 5;
+	EXPECT_EQ(cache.get(item).bonusDamage, 45);
+
+	item._iStatFlag = false;
+	EXPECT_EQ(cache.get(item), ItemStatBonuses {});
+
+	item.clear();
+	EXPECT_EQ(cache.get(item), ItemStatBonuses {});
+}
+
+} // namespace
+} // namespace devilution
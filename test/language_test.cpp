@@ -0,0 +1,53 @@
+#include <gtest/gtest.h>
+
+#include <cstring>
+
+#include "utils/language.h"
+
+namespace devilution {
+namespace {
+
+string_view TranslateLiteral()
+{
+	return _("Literal key");
+}
+
+TEST(LanguageTest, LiteralCallSiteIsCached)
+{
+	const string_view first = TranslateLiteral();
+	EXPECT_EQ(first, "Literal key");
+	EXPECT_EQ(TranslateLiteral().data(), first.data());
+}
+
+TEST(LanguageTest, NonLiteralKeyIsNotCached)
+{
+	char key[16];
+	std::strcpy(key, "First");
+	EXPECT_EQ(_(key), "First");
+	std::strcpy(key, "Second");
+	EXPECT_EQ(_(key), "Second");
+
+	const std::string stringKey = "Third";
+	EXPECT_EQ(_(stringKey), "Third");
+}
+
+TEST(LanguageTest, ParticularTranslateFallsBackToMessage)
+{
+	EXPECT_EQ(pgettext("context", "Message"), "Message");
+	const char *context = "context";
+	EXPECT_EQ(pgettext(context, "Message"), "Message");
+}
+
+TEST(LanguageTest, GenerationChangeInvalidatesCache)
+{
+	TranslationCache cache;
+	cache.generation = TranslationGeneration;
+	cache.value = "Stale";
+	EXPECT_EQ(LanguageTranslateAt<true>("Fresh", [&]() -> TranslationCache & { return cache; }), "Stale");
+	TranslationGeneration++;
+	EXPECT_EQ(LanguageTranslateAt<true>("Fresh", [&]() -> TranslationCache & { return cache; }), "Fresh");
+	EXPECT_EQ(cache.generation.load(), TranslationGeneration);
+}
+
+} // namespace
+} // namespace devilution
@@ -0,0 +1,136 @@
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "codec.h"
+#include "encrypt.h"
+#include "mpq/mpq_reader.hpp"
+#include "mpq/mpq_writer.hpp"
+#include "utils/stdcompat/optional.hpp"
+
+using namespace devilution;
+
+namespace {
+
+// Level saves are a little under 100 KiB before encoding.
+constexpr size_t LevelSaveSize = 96 * 1024;
+
+/**
+ * @brief Data that compresses roughly as well as a save file does before it is encoded.
+ */
+std::vector<byte> MakeSaveLikeData(size_t size, uint32_t seed)
+{
+	std::vector<byte> data(size);
+	for (size_t i = 0; i < size; i++) {
+		seed = seed * 1103515245 + 12345;
+		// Mostly runs of zeros with some noise, like the dungeon maps.
+		data[i] = (seed >> 24) < 48 ? static_cast<byte>(seed >> 16) : byte { 0 };
+	}
+	return data;
+}
+
+std::string TempArchivePath(const char *name)
+{
+	const std::filesystem::path path = std::filesystem::temp_directory_path() / name;
+	std::filesystem::remove(path);
+	return path.string();
+}
+
+TEST(MpqWriter, PkwareCompressToSeparateBuffer)
+{
+	std::vector<byte> source = MakeSaveLikeData(4096, 1);
+	std::vector<byte> inPlace = source;
+	std::vector<byte> separate(source.size());
+
+	const uint32_t inPlaceSize = PkwareCompress(inPlace.data(), static_cast<uint32_t>(inPlace.size()));
+	const uint32_t separateSize = PkwareCompress(source.data(), static_cast<uint32_t>(source.size()), separate.data());
+
+	ASSERT_EQ(separateSize, inPlaceSize);
+	EXPECT_LT(separateSize, source.size());
+	EXPECT_EQ(memcmp(separate.data(), inPlace.data(), separateSize), 0);
+}
+
+TEST(MpqWriter, PkwareCompressStoresIncompressibleData)
+{
+	std::vector<byte> source(64);
+	for (size_t i = 0; i < source.size(); i++)
+		source[i] = static_cast<byte>(i * 37);
+	std::vector<byte> dest(source.size());
+
+	EXPECT_EQ(PkwareCompress(source.data(), static_cast<uint32_t>(source.size()), dest.data()), source.size());
+	EXPECT_EQ(dest, source);
+}
+
+TEST(MpqWriter, WriteFileRoundTrip)
+{
+	const std::string path = TempArchivePath("mpq_writer_test.sv");
+	// Several full sectors followed by a partial one.
+	const std::vector<byte> multiSector = MakeSaveLikeData(10 * 4096 + 123, 2);
+	const std::vector<byte> singleSector = MakeSaveLikeData(100, 3);
+	{
+		MpqWriter writer(path);
+		ASSERT_TRUE(writer.WriteFile("multi", multiSector.data(), multiSector.size()));
+		ASSERT_TRUE(writer.WriteFile("single", singleSector.data(), singleSector.size()));
+	}
+
+	int32_t error = 0;
+	std::optional<MpqArchive> archive = MpqArchive::Open(path.c_str(), error);
+	ASSERT_TRUE(archive);
+
+	size_t size;
+	std::unique_ptr<byte[]> data = archive->ReadFile("multi", size, error);
+	ASSERT_NE(data, nullptr);
+	ASSERT_EQ(size, multiSector.size());
+	EXPECT_EQ(memcmp(data.get(), multiSector.data(), size), 0);
+
+	data = archive->ReadFile("single", size, error);
+	ASSERT_NE(data, nullptr);
+	ASSERT_EQ(size, singleSector.size());
+	EXPECT_EQ(memcmp(data.get(), singleSector.data(), size), 0);
+
+	archive = std::nullopt;
+	std::filesystem::remove(path);
+}
+
+// Run with --gtest_also_run_disabled_tests to compare save times.
+TEST(MpqWriter, DISABLED_BenchmarkMultiplayerSave)
+{
+	constexpr int Iterations = 20;
+	// Hero, game, and a temp and perm file for each of the 17 levels.
+	std::vector<std::pair<std::string, std::vector<byte>>> files;
+	files.emplace_back("hero", MakeSaveLikeData(2 * 1024, 0));
+	files.emplace_back("game", MakeSaveLikeData(160 * 1024, 1));
+	for (int level = 0; level <= 16; level++) {
+		for (const char *prefix : { "temp", "perm" }) {
+			files.emplace_back(prefix + std::string(level < 10 ? "l0" : "l") + std::to_string(level), MakeSaveLikeData(LevelSaveSize, level));
+		}
+	}
+	for (auto &file : files) {
+		std::vector<byte> &data = file.second;
+		const size_t size = data.size();
+		const size_t encodedLen = codec_get_encoded_len(size);
+		data.resize(encodedLen);
+		codec_encode(data.data(), size, encodedLen, "szqnlsk1");
+	}
+
+	const std::string path = TempArchivePath("mpq_writer_benchmark.sv");
+	const auto start = std::chrono::steady_clock::now();
+	for (int i = 0; i < Iterations; i++) {
+		MpqWriter writer(path);
+		for (const auto &file : files)
+			ASSERT_TRUE(writer.WriteFile(file.first.c_str(), file.second.data(), file.second.size()));
+	}
+	const auto elapsed = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start);
+	std::cout << "Multiplayer save with " << files.size() << " files: " << elapsed.count() / Iterations << " us per save" << std::endl;
+	std::filesystem::remove(path);
+}
+
+} // namespace
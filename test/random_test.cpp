@@ -1,3 +1,5 @@
+#include <thread>
+
 #include <gtest/gtest.h>
 
 #include "engine/random.hpp"
@@ -287,4 +289,24 @@ TEST(RandomTest, NegativeReturnValues)
 		EXPECT_EQ(GenerateRnd(i), 0) << "Expect powers of 2 such as " << i << " to cleanly divide the int_min RNG value ";
 	}
 }
+
+TEST(RandomTest, StateIsPerThread)
+{
+	SetRndSeed(1234);
+	uint32_t threadStartState = 1;
+	uint32_t threadState = 0;
+	std::thread thread([&]() {
+		threadStartState = GetLCGEngineState();
+		SetRndSeed(5678);
+		AdvanceRndSeed();
+		threadState = GetLCGEngineState();
+	});
+	thread.join();
+
+	EXPECT_EQ(GetLCGEngineState(), 1234U) << "Another thread should not change this thread's state";
+	EXPECT_EQ(threadStartState, 0U) << "A new thread should start from a state of 0";
+	SetRndSeed(5678);
+	AdvanceRndSeed();
+	EXPECT_EQ(threadState, GetLCGEngineState()) << "Threads should produce the same sequence from the same seed";
+}
 } // namespace devilution
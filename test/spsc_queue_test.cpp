@@ -0,0 +1,85 @@
+#include <cstdint>
+#include <thread>
+
+#include <gtest/gtest.h>
+
+#include "utils/spsc_queue.hpp"
+
+using namespace devilution;
+
+namespace {
+
+TEST(SpscQueueTest, FirstInFirstOut)
+{
+	SpscQueue<int, 4> queue;
+	int value;
+	EXPECT_FALSE(queue.pop(value));
+
+	EXPECT_TRUE(queue.push(1));
+	EXPECT_TRUE(queue.push(2));
+	EXPECT_EQ(queue.size(), 2U);
+	ASSERT_TRUE(queue.pop(value));
+	EXPECT_EQ(value, 1);
+	ASSERT_TRUE(queue.pop(value));
+	EXPECT_EQ(value, 2);
+	EXPECT_FALSE(queue.pop(value));
+	EXPECT_EQ(queue.size(), 0U);
+}
+
+TEST(SpscQueueTest, RejectsPushWhenFull)
+{
+	SpscQueue<int, 4> queue;
+	for (int i = 0; i < 4; i++)
+		EXPECT_TRUE(queue.push(i));
+	EXPECT_FALSE(queue.push(4));
+
+	int value;
+	ASSERT_TRUE(queue.pop(value));
+	EXPECT_EQ(value, 0);
+	EXPECT_TRUE(queue.push(4));
+	for (int i = 1; i <= 4; i++) {
+		ASSERT_TRUE(queue.pop(value));
+		EXPECT_EQ(value, i);
+	}
+}
+
+TEST(SpscQueueTest, WrapsAround)
+{
+	SpscQueue<int, 4> queue;
+	int value;
+	for (int i = 0; i < 100; i++) {
+		ASSERT_TRUE(queue.push(i));
+		ASSERT_TRUE(queue.push(-i));
+		ASSERT_TRUE(queue.pop(value));
+		EXPECT_EQ(value, i);
+		ASSERT_TRUE(queue.pop(value));
+		EXPECT_EQ(value, -i);
+	}
+}
+
+TEST(SpscQueueTest, TransfersBetweenThreads)
+{
+	constexpr uint32_t Count = 100000;
+	SpscQueue<uint32_t, 64> queue;
+	std::thread producer([&]() {
+		for (uint32_t i = 0; i < Count; i++) {
+			while (!queue.push(i))
+				std::this_thread::yield();
+		}
+	});
+
+	uint32_t expected = 0;
+	uint32_t value;
+	while (expected < Count) {
+		if (!queue.pop(value)) {
+			std::this_thread::yield();
+			continue;
+		}
+		ASSERT_EQ(value, expected);
+		expected++;
+	}
+	producer.join();
+	EXPECT_EQ(queue.size(), 0U);
+}
+
+} // namespace
@@ -0,0 +1,150 @@
+#include <cstdio>
+#include <filesystem>
+#include <string>
+
+#include <gtest/gtest.h>
+
+#include "diablo.h"
+#include "engine/demomode.h"
+#include "missiles.h"
+#include "monster.h"
+#include "objects.h"
+#include "statehash.h"
+#include "utils/paths.h"
+
+namespace devilution {
+namespace {
+
+class StateHashTest : public ::testing::Test {
+public:
+	void SetUp() override
+	{
+		Missiles.clear();
+		ActiveMonsterCount = 1;
+		ActiveMonsters[0] = 0;
+		Monsters[0] = {};
+		ActiveObjectCount = 0;
+	}
+
+	void TearDown() override
+	{
+		Missiles.clear();
+		ActiveMonsterCount = 0;
+	}
+};
+
+TEST_F(StateHashTest, SameStateSameHash)
+{
+	EXPECT_EQ(ComputeGameStateHash(), ComputeGameStateHash());
+}
+
+TEST_F(StateHashTest, MonsterChangeOnlyAffectsMonsterHash)
+{
+	const GameStateHash before = ComputeGameStateHash();
+	Monsters[0].hitPoints = 10 << 6;
+	const GameStateHash after = ComputeGameStateHash();
+
+	EXPECT_NE(before.monsters, after.monsters);
+	EXPECT_EQ(before.players, after.players);
+	EXPECT_EQ(before.missiles, after.missiles);
+	EXPECT_EQ(before.items, after.items);
+	EXPECT_EQ(before.objects, after.objects);
+}
+
+TEST_F(StateHashTest, MissileOrderMatters)
+{
+	Missiles.emplace_back().position.tile = { 1, 2 };
+	Missiles.emplace_back().position.tile = { 3, 4 };
+	const GameStateHash before = ComputeGameStateHash();
+	Missiles.reverse();
+	EXPECT_NE(before.missiles, ComputeGameStateHash().missiles);
+}
+
+#ifndef DISABLE_DEMOMODE
+class StateHashDemoTest : public StateHashTest {
+public:
+	static constexpr int NumTicks = 4;
+
+	void SetUp() override
+	{
+		StateHashTest::SetUp();
+		HeadlessMode = true;
+		dir_ = std::filesystem::temp_directory_path() / "statehash_test";
+		std::filesystem::remove_all(dir_);
+		std::filesystem::create_directories(dir_);
+		paths::SetPrefPath(dir_.string());
+	}
+
+	void TearDown() override
+	{
+		std::filesystem::remove_all(dir_);
+		StateHashTest::TearDown();
+	}
+
+	/** @brief Changes the simulated state the same way on every run. */
+	static void SimulateTick(int tick)
+	{
+		Monsters[0].hitPoints = (tick + 1) << 6;
+	}
+
+	static void Record()
+	{
+		demo::InitRecording(0, false);
+		demo::NotifyGameLoopStart();
+		for (int tick = 0; tick < NumTicks; tick++) {
+			demo::RecordGameLoopResult(true);
+			SimulateTick(tick);
+		}
+		demo::NotifyGameLoopEnd();
+	}
+
+	static void Replay()
+	{
+		demo::InitPlayBack(0, /*timedemo=*/true);
+		demo::NotifyGameLoopStart();
+		for (int tick = 0; tick < NumTicks; tick++) {
+			bool drawGame;
+			bool processInput;
+			ASSERT_TRUE(demo::GetRunGameLoop(drawGame, processInput));
+			SimulateTick(tick);
+		}
+	}
+
+	std::filesystem::path dir_;
+};
+
+TEST_F(StateHashDemoTest, ReplayMatchesRecording)
+{
+	Record();
+	Monsters[0] = {};
+	Replay();
+	EXPECT_EQ(demo::GetStateDivergence().tick, -1);
+	EXPECT_EQ(demo::GetStateDivergence().parts, "");
+}
+
+TEST_F(StateHashDemoTest, TamperedHashReportsTickAndPart)
+{
+	Record();
+
+	// Version, save number and resolution, then per tick the message type, progress and five hashes.
+	constexpr long HeaderSize = 1 + 4 + 2 + 2;
+	constexpr long TickSize = 4 + 1 + 5 * 4;
+	constexpr int TamperedTick = 2;
+	FILE *demo = std::fopen((dir_ / "demo_0.dmo").string().c_str(), "r+b");
+	ASSERT_NE(demo, nullptr);
+	// The monsters hash is the second one.
+	std::fseek(demo, HeaderSize + TamperedTick * TickSize + 4 + 1 + 4, SEEK_SET);
+	const int byte = std::fgetc(demo);
+	std::fseek(demo, -1, SEEK_CUR);
+	std::fputc(byte ^ 0xFF, demo);
+	std::fclose(demo);
+
+	Monsters[0] = {};
+	Replay();
+	EXPECT_EQ(demo::GetStateDivergence().tick, TamperedTick);
+	EXPECT_EQ(demo::GetStateDivergence().parts, "monsters");
+}
+#endif
+
+} // namespace
+} // namespace devilution
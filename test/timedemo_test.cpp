@@ -1,6 +1,8 @@
 #include <filesystem>
+#include <fstream>
 #include <gtest/gtest.h>
 #include <iostream>
+#include <iterator>
 
 #include "diablo.h"
 #include "engine/demomode.h"
@@ -47,6 +49,9 @@ void RunTimedemo(std::string timedemoFolderName)
 	gbSoundOn = false;
 	HeadlessMode = true;
 	demo::InitPlayBack(demoNumber, true);
+	const std::string benchmarkPath = (std::filesystem::temp_directory_path() / "timedemo_benchmark.json").string();
+	std::filesystem::remove(benchmarkPath);
+	demo::InitBenchmark(benchmarkPath);
 
 	pfile_ui_set_hero_infos(Dummy_GetHeroInfo);
 	gbLoadGame = true;
@@ -61,6 +66,13 @@ void RunTimedemo(std::string timedemoFolderName)
 	ASSERT_EQ(result.status, HeroCompareResult::Same) << result.message;
 	ASSERT_FALSE(gbRunGame);
 	gbRunGame = false;
+
+	std::ifstream benchmark(benchmarkPath);
+	ASSERT_TRUE(benchmark.is_open());
+	const std::string report { std::istreambuf_iterator<char>(benchmark), std::istreambuf_iterator<char>() };
+	EXPECT_NE(report.find("\"frames\": "), std::string::npos);
+	EXPECT_NE(report.find("\"p99_us\": "), std::string::npos);
+	EXPECT_EQ(report.find("\"frames\": 0,"), std::string::npos);
 	init_cleanup();
 }
 
@@ -1,7 +1,10 @@
 #include "player_test.h"
 
+#include <chrono>
 #include <cstdint>
 #include <cstdio>
+#include <filesystem>
+#include <string>
 #include <vector>
 
 #include <SDL_endian.h>
@@ -404,5 +407,127 @@ TEST(Writehero, pfile_write_hero)
 	    "a79367caae6192d54703168d82e0316aa289b2a33251255fad8abe34889c1d3a");
 }
 
+std::vector<_uiheroinfo> CollectedHeroes;
+
+bool CollectHeroInfo(_uiheroinfo *info)
+{
+	CollectedHeroes.push_back(*info);
+	return true;
+}
+
+std::vector<_uiheroinfo> ListHeroes()
+{
+	CollectedHeroes.clear();
+	pfile_ui_set_hero_infos(CollectHeroInfo);
+	return CollectedHeroes;
+}
+
+void AssertSameHeroes(const std::vector<_uiheroinfo> &expected, const std::vector<_uiheroinfo> &actual)
+{
+	ASSERT_EQ(expected.size(), actual.size());
+	for (size_t i = 0; i < expected.size(); i++) {
+		EXPECT_EQ(expected[i].saveNumber, actual[i].saveNumber);
+		EXPECT_STREQ(expected[i].name, actual[i].name);
+		EXPECT_EQ(expected[i].level, actual[i].level);
+		EXPECT_EQ(expected[i].heroclass, actual[i].heroclass);
+		EXPECT_EQ(expected[i].herorank, actual[i].herorank);
+		EXPECT_EQ(expected[i].strength, actual[i].strength);
+		EXPECT_EQ(expected[i].magic, actual[i].magic);
+		EXPECT_EQ(expected[i].dexterity, actual[i].dexterity);
+		EXPECT_EQ(expected[i].vitality, actual[i].vitality);
+		EXPECT_EQ(expected[i].hassaved, actual[i].hassaved);
+	}
+}
+
+class WriteheroIndexTest : public ::testing::Test {
+protected:
+	void SetUp() override
+	{
+		dir_ = std::filesystem::temp_directory_path() / "writehero_index_test";
+		std::filesystem::remove_all(dir_);
+		std::filesystem::create_directories(dir_);
+		paths::SetPrefPath(dir_.string());
+
+		gbVanilla = true;
+		gbIsHellfire = false;
+		gbIsMultiplayer = true;
+		giNumberOfLevels = 17;
+
+		Players.resize(1);
+		MyPlayerId = 0;
+		MyPlayer = &Players[MyPlayerId];
+	}
+
+	void TearDown() override
+	{
+		paths::SetPrefPath(".");
+		std::filesystem::remove_all(dir_);
+	}
+
+	static _uiheroinfo CreateHero(uint32_t saveNumber, const char *name, HeroClass heroClass)
+	{
+		_uiheroinfo info {};
+		info.saveNumber = saveNumber;
+		strcpy(info.name, name);
+		info.heroclass = heroClass;
+		pfile_ui_save_create(&info);
+		return info;
+	}
+
+	std::filesystem::path SavePath(uint32_t saveNumber) const
+	{
+		return dir_ / ("multi_" + std::to_string(saveNumber) + ".sv");
+	}
+
+	std::filesystem::path dir_;
+};
+
+TEST_F(WriteheroIndexTest, pfile_ui_set_hero_infos_index)
+{
+	_uiheroinfo info = CreateHero(1, "IndexedPlayer", HeroClass::Sorcerer);
+	CreateHero(2, "OtherPlayer", HeroClass::Warrior);
+
+	const std::vector<_uiheroinfo> scanned = ListHeroes();
+	ASSERT_TRUE(std::filesystem::exists(dir_ / "multi_heroes.idx"));
+	ASSERT_EQ(scanned.size(), 2U);
+	EXPECT_EQ(scanned[0].saveNumber, 1U);
+	EXPECT_STREQ(scanned[0].name, "IndexedPlayer");
+	EXPECT_EQ(scanned[0].heroclass, HeroClass::Sorcerer);
+	EXPECT_EQ(scanned[1].saveNumber, 2U);
+	EXPECT_STREQ(scanned[1].name, "OtherPlayer");
+	EXPECT_EQ(scanned[1].heroclass, HeroClass::Warrior);
+	EXPECT_EQ(pfile_ui_get_first_unused_save_num(), 0U);
+
+	// A valid entry is served from the index without decoding the save: garble
+	// the save while keeping its size and modification time.
+	const std::filesystem::path save1 = SavePath(1);
+	const std::filesystem::file_time_type save1Time = std::filesystem::last_write_time(save1);
+	const std::uintmax_t save1Size = std::filesystem::file_size(save1);
+	{
+		FILE *file = std::fopen(save1.string().c_str(), "r+b");
+		ASSERT_NE(file, nullptr);
+		const std::vector<char> garbage(save1Size, '\xAA');
+		ASSERT_EQ(std::fwrite(garbage.data(), 1, garbage.size(), file), garbage.size());
+		std::fclose(file);
+	}
+	std::filesystem::last_write_time(save1, save1Time);
+	AssertSameHeroes(scanned, ListHeroes());
+
+	// A save that was rewritten after indexing is decoded again.
+	std::filesystem::copy_file(SavePath(2), save1, std::filesystem::copy_options::overwrite_existing);
+	std::filesystem::last_write_time(save1, save1Time + std::chrono::hours(1));
+	const std::vector<_uiheroinfo> rebuilt = ListHeroes();
+	ASSERT_EQ(rebuilt.size(), 2U);
+	EXPECT_EQ(rebuilt[0].saveNumber, 1U);
+	EXPECT_STREQ(rebuilt[0].name, "OtherPlayer");
+	EXPECT_EQ(rebuilt[0].heroclass, HeroClass::Warrior);
+
+	pfile_delete_save(&info);
+	const std::vector<_uiheroinfo> afterDelete = ListHeroes();
+	ASSERT_EQ(afterDelete.size(), 1U);
+	EXPECT_EQ(afterDelete[0].saveNumber, 2U);
+	EXPECT_EQ(pfile_ui_get_first_unused_save_num(), 0U);
+}
+
 } // namespace
 } // namespace devilution
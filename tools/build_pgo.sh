@@ -9,10 +9,11 @@ set -x
 
 rm -rf build-profile-data/config build-profile-data/profile
 mkdir -p build-profile-data/config
-cd build-profile-data/config
-ln -s ../../test/fixtures/timedemo/WarriorLevel1to2/demo_* .
-cp ../../test/fixtures/timedemo/WarriorLevel1to2/spawn_* .
-cd -
+for fixture in test/fixtures/timedemo/*/; do
+  fixture_name="$(basename "$fixture")"
+  mkdir -p "build-profile-data/config/${fixture_name}"
+  cp "${fixture}"demo_* "${fixture}"spawn_* "build-profile-data/config/${fixture_name}/"
+done
 
 # We build both versions with the same FetchContent base directory because otherwise
 # gcc will complain about the source locations for FetchContent dependencies,
@@ -25,8 +26,16 @@ cmake -S. -Bbuild-profile-generate -G Ninja -DCMAKE_BUILD_TYPE=Release \
   -DFETCHCONTENT_BASE_DIR="${PWD}/build-profile-data/fetchcontent-base" \
   -DBUILD_TESTING=OFF "$@"
 cmake --build build-profile-generate -j "$PARALLELISM"
-build-profile-generate/devilutionx --diablo --spawn --lang en --demo 0 --timedemo \
-  --save-dir build-profile-data/config
+# Every demo of every fixture is used as profile driver.
+for config_dir in build-profile-data/config/*/; do
+  for demo in "${config_dir}"demo_*.dmo; do
+    demo_number="$(basename "$demo" .dmo)"
+    demo_number="${demo_number#demo_}"
+    [[ "$demo_number" =~ ^[0-9]+$ ]] || continue
+    build-profile-generate/devilutionx --diablo --spawn --lang en --demo "$demo_number" --timedemo \
+      --benchmark "${config_dir}benchmark_${demo_number}.json" --save-dir "$config_dir"
+  done
+done
 
 cmake -S. -Bbuild-profile-use -G Ninja -DCMAKE_BUILD_TYPE=Release \
   -DDEVILUTIONX_PROFILE_USE=ON \
@@ -1,43 +1,118 @@
 #!/usr/bin/env python
 
 import argparse
+import json
+import os
 import re
 import sys
 import statistics
 import subprocess
-from typing import NamedTuple
+import tempfile
+from typing import Dict, List, NamedTuple, Optional
 
 _TIME_AND_FPS_REGEX = re.compile(rb'\d+ frames, (\d+(?:\.\d+)?) seconds: (\d+(?:\.\d+)?) fps')
+_DEMO_FILE_REGEX = re.compile(r'^demo_(\d+)\.dmo$')
+_REPORTED_STATS = ('p50_us', 'p95_us', 'p99_us', 'max_us', 'stddev_us')
 
 class RunMetrics(NamedTuple):
 	time: float
 	fps: float
+	benchmark: Optional[dict]
 
-def measure(binary: str) -> RunMetrics:
-	result: subprocess.CompletedProcess = subprocess.run(
-		[binary, '--diablo', '--spawn', '--lang', 'en', '--demo', '0', '--timedemo'], capture_output=True)
-	match = _TIME_AND_FPS_REGEX.search(result.stderr)
-	if not match:
-		raise Exception(f"Failed to parse output in:\n{result.stderr}")
-	return RunMetrics(float(match.group(1)), float(match.group(2)))
+def find_demos(save_dir: Optional[str]) -> List[int]:
+	if save_dir is None:
+		return [0]
+	demos = []
+	for name in os.listdir(save_dir):
+		match = _DEMO_FILE_REGEX.match(name)
+		if match:
+			demos.append(int(match.group(1)))
+	return sorted(demos)
 
+def measure(binary: str, demo: int, save_dir: Optional[str]) -> RunMetrics:
+	with tempfile.TemporaryDirectory() as tmp_dir:
+		report_path = os.path.join(tmp_dir, 'benchmark.json')
+		command = [binary, '--diablo', '--spawn', '--lang', 'en', '--demo', str(demo), '--timedemo', '--benchmark', report_path]
+		if save_dir is not None:
+			command += ['--save-dir', save_dir]
+		result: subprocess.CompletedProcess = subprocess.run(command, capture_output=True)
+		match = _TIME_AND_FPS_REGEX.search(result.stderr)
+		if not match:
+			raise Exception(f"Failed to parse output in:\n{result.stderr}")
+		benchmark = None
+		if os.path.exists(report_path):
+			with open(report_path) as f:
+				benchmark = json.load(f)
+		return RunMetrics(float(match.group(1)), float(match.group(2)), benchmark)
+
+def summarize(runs: List[RunMetrics]) -> dict:
+	"""Reduces the runs of a single demo to the median of each statistic."""
+	summary = {
+		'time': statistics.median(m.time for m in runs),
+		'fps': statistics.median(m.fps for m in runs),
+	}
+	benchmarks = [m.benchmark for m in runs if m.benchmark is not None]
+	if benchmarks:
+		for section in ('logic', 'render', 'present', 'frame'):
+			if all(section in b for b in benchmarks):
+				summary[section] = {stat: statistics.median(b[section][stat] for b in benchmarks) for stat in _REPORTED_STATS if all(stat in b[section] for b in benchmarks)}
+		summary['hitches'] = statistics.median(b['hitches']['over_twice_median'] for b in benchmarks)
+		if all('jitter_us' in b for b in benchmarks):
+			summary['jitter'] = statistics.median(b['jitter_us'] for b in benchmarks)
+	return summary
+
+def print_comparison(baseline: Dict[str, dict], current: Dict[str, dict]):
+	for demo, summary in current.items():
+		if demo not in baseline:
+			print(f"demo {demo}: not present in baseline")
+			continue
+		base = baseline[demo]
+		print(f"demo {demo}: {base['fps']:.1f} -> {summary['fps']:.1f} FPS")
+		for section in ('logic', 'render', 'present', 'frame'):
+			if section not in base or section not in summary:
+				continue
+			# Reports written by older versions lack some of the statistics.
+			stats = [stat for stat in _REPORTED_STATS if stat in base[section] and stat in summary[section]]
+			deltas = ', '.join(f"{stat} {base[section][stat]:.0f} -> {summary[section][stat]:.0f}" for stat in stats)
+			print(f"\t{section:<7} {deltas}")
+		if 'hitches' in base and 'hitches' in summary:
+			print(f"\thitches {base['hitches']:.0f} -> {summary['hitches']:.0f}")
+		if 'jitter' in base and 'jitter' in summary:
+			print(f"\tjitter  {base['jitter']:.0f} -> {summary['jitter']:.0f} us")
 
 def main():
 	parser = argparse.ArgumentParser()
 	parser.add_argument('--binary', help='Path to the devilutionx binary', required=True)
+	parser.add_argument('--save-dir', help='Folder containing the demo_*.dmo files, all of which are run')
 	parser.add_argument('-n', '--num-runs', type=int, default=16, metavar='N')
+	parser.add_argument('--json', help='Write the per-demo results to this file', metavar='FILE')
+	parser.add_argument('--compare', help='Compare against the results of a previous --json run', metavar='FILE')
 	args = parser.parse_args()
 
 	num_runs = args.num_runs
-	metrics = []
-	for i in range(1, num_runs + 1):
-		print(f"Run {i:>2} of {num_runs}: ", end='', file=sys.stderr, flush=True)
-		run_metrics = measure(args.binary)
-		print(f"\t{run_metrics.time:>5.2f} seconds\t{run_metrics.fps:>5.1f} FPS", file=sys.stderr, flush=True)
-		metrics.append(run_metrics)
-
-	mean = RunMetrics(statistics.mean(m.time for m in metrics), statistics.mean(m.fps for m in metrics))
-	stdev = RunMetrics(statistics.stdev((m.time for m in metrics), mean.time), statistics.stdev((m.fps for m in metrics), mean.fps))
-	print(f"{mean.time:.3f} ± {stdev.time:.3f} seconds, {mean.fps:.3f} ± {stdev.fps:.3f} FPS")
+	results = {}
+	for demo in find_demos(args.save_dir):
+		metrics = []
+		for i in range(1, num_runs + 1):
+			print(f"Demo {demo} run {i:>2} of {num_runs}: ", end='', file=sys.stderr, flush=True)
+			run_metrics = measure(args.binary, demo, args.save_dir)
+			print(f"\t{run_metrics.time:>5.2f} seconds\t{run_metrics.fps:>5.1f} FPS", file=sys.stderr, flush=True)
+			metrics.append(run_metrics)
+
+		mean = RunMetrics(statistics.mean(m.time for m in metrics), statistics.mean(m.fps for m in metrics), None)
+		if num_runs > 1:
+			stdev = RunMetrics(statistics.stdev((m.time for m in metrics), mean.time), statistics.stdev((m.fps for m in metrics), mean.fps), None)
+			print(f"demo {demo}: {mean.time:.3f} ± {stdev.time:.3f} seconds, {mean.fps:.3f} ± {stdev.fps:.3f} FPS")
+		else:
+			print(f"demo {demo}: {mean.time:.3f} seconds, {mean.fps:.3f} FPS")
+		results[str(demo)] = summarize(metrics)
+
+	if args.json:
+		with open(args.json, 'w') as f:
+			json.dump(results, f, indent=2, sort_keys=True)
+
+	if args.compare:
+		with open(args.compare) as f:
+			print_comparison(json.load(f), results)
 
 main()
@@ -0,0 +1,229 @@
+/**
+ * @file seed_scanner.cpp
+ *
+ * Recreates an item for every seed in a range on all cores and prints the seeds whose item passes the given filters,
+ * e.g. to check whether an item could have been generated legitimately.
+ */
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include <SDL.h>
+#include <fmt/format.h>
+
+#include "diablo.h"
+#include "init.h"
+#include "items.h"
+#include "multi.h"
+#include "player.h"
+#include "utils/stdcompat/optional.hpp"
+#include "utils/stdcompat/string_view.hpp"
+#include "utils/worker_pool.hpp"
+
+using namespace devilution;
+
+namespace {
+
+/** @brief Seeds recreated by one task of the worker pool. */
+constexpr uint32_t SeedsPerChunk = 1 << 16;
+
+/** @brief Chunks scanned before the matches are printed, bounds the memory used for the results. */
+constexpr uint32_t ChunksPerBatch = 256;
+
+struct ScanOptions {
+	_item_indexes idx = IDI_NONE;
+	uint16_t createInfo = 0;
+	int value = 0;
+	uint32_t firstSeed = 0;
+	uint64_t numSeeds = 1 << 24;
+	HeroClass heroClass = HeroClass::Warrior;
+	bool hellfire = false;
+	bool multiplayer = false;
+	unsigned numThreads = static_cast<unsigned>(std::max(SDL_GetCPUCount(), 1));
+	std::optional<item_quality> quality;
+	std::optional<item_effect_type> prefix;
+	std::optional<item_effect_type> suffix;
+	std::optional<int> unique;
+};
+
+struct Match {
+	int seed;
+	item_quality quality;
+	item_effect_type prefix;
+	item_effect_type suffix;
+	int unique;
+	std::string name;
+};
+
+void PrintUsage()
+{
+	std::fputs("Usage: seed_scanner --item <index> --createinfo <value> [options]\n"
+	           "\n"
+	           "Recreates the item for every seed in the range and prints the matching seeds as CSV.\n"
+	           "\n"
+	           "Options:\n"
+	           "    --value <value>      Value passed to RecreateItem, used by gold and ears\n"
+	           "    --first <seed>       First seed to scan (default 0)\n"
+	           "    --count <n>          Number of seeds to scan (default 16777216)\n"
+	           "    --class <index>      Hero class the item is recreated for (default 0, warrior)\n"
+	           "    --hellfire           Recreate Hellfire items\n"
+	           "    --multiplayer        Recreate items of a multiplayer game\n"
+	           "    --threads <n>        Number of threads to use (default: all cores)\n"
+	           "\n"
+	           "Filters:\n"
+	           "    --quality <index>    Only print items of this item_quality\n"
+	           "    --prefix <index>     Only print items with this item_effect_type as prefix\n"
+	           "    --suffix <index>     Only print items with this item_effect_type as suffix\n"
+	           "    --unique <index>     Only print this unique item\n",
+	    stderr);
+}
+
+bool ParseNumber(string_view arg, const char *value, uint64_t &out)
+{
+	char *end;
+	out = std::strtoull(value, &end, 0);
+	if (*value == '\0' || *end != '\0') {
+		std::fprintf(stderr, "%.*s expects a number, got '%s'\n", static_cast<int>(arg.size()), arg.data(), value);
+		return false;
+	}
+	return true;
+}
+
+bool ParseOptions(int argc, char **argv, ScanOptions &options)
+{
+	for (int i = 1; i < argc; i++) {
+		const string_view arg = argv[i];
+		if (arg == "-h" || arg == "--help") {
+			return false;
+		} else if (arg == "--hellfire") {
+			options.hellfire = true;
+			continue;
+		} else if (arg == "--multiplayer") {
+			options.multiplayer = true;
+			continue;
+		}
+
+		if (i + 1 == argc) {
+			std::fprintf(stderr, "%s requires an argument\n", argv[i]);
+			return false;
+		}
+		uint64_t value;
+		if (!ParseNumber(arg, argv[++i], value))
+			return false;
+		if (arg == "--item") {
+			options.idx = static_cast<_item_indexes>(value);
+		} else if (arg == "--createinfo") {
+			options.createInfo = static_cast<uint16_t>(value);
+		} else if (arg == "--value") {
+			options.value = static_cast<int>(value);
+		} else if (arg == "--first") {
+			options.firstSeed = static_cast<uint32_t>(value);
+		} else if (arg == "--count") {
+			options.numSeeds = std::min<uint64_t>(value, uint64_t { 1 } << 32);
+		} else if (arg == "--class") {
+			options.heroClass = static_cast<HeroClass>(std::min<uint64_t>(value, static_cast<uint64_t>(HeroClass::LAST)));
+		} else if (arg == "--threads") {
+			options.numThreads = static_cast<unsigned>(std::max<uint64_t>(value, 1));
+		} else if (arg == "--quality") {
+			options.quality = static_cast<item_quality>(value);
+		} else if (arg == "--prefix") {
+			options.prefix = static_cast<item_effect_type>(value);
+		} else if (arg == "--suffix") {
+			options.suffix = static_cast<item_effect_type>(value);
+		} else if (arg == "--unique") {
+			options.unique = static_cast<int>(value);
+		} else {
+			std::fprintf(stderr, "unrecognized option '%s'\n", argv[i - 1]);
+			return false;
+		}
+	}
+
+	if (options.idx == IDI_NONE) {
+		std::fputs("--item is required\n", stderr);
+		return false;
+	}
+	return true;
+}
+
+bool IsMatch(const ScanOptions &options, const Item &item)
+{
+	return (!options.quality || item._iMagical == *options.quality)
+	    && (!options.prefix || item._iPrePower == *options.prefix)
+	    && (!options.suffix || item._iSufPower == *options.suffix)
+	    && (!options.unique || (item._iMagical == ITEM_QUALITY_UNIQUE && item._iUid == *options.unique));
+}
+
+void ScanChunk(const ScanOptions &options, uint64_t first, uint64_t last, std::vector<Match> &matches)
+{
+	for (uint64_t i = first; i < last; i++) {
+		const auto seed = static_cast<int>(static_cast<uint32_t>(options.firstSeed + i));
+		// Which uniques have dropped is per thread, every item is recreated as if it were the first in the game.
+		std::memset(UniqueItemFlags, 0, sizeof(UniqueItemFlags));
+		Item item {};
+		RecreateItem(*MyPlayer, item, options.idx, options.createInfo, seed, options.value, options.hellfire);
+		if (IsMatch(options, item))
+			matches.push_back(Match { seed, item._iMagical, item._iPrePower, item._iSufPower, item._iUid, item._iIName });
+	}
+}
+
+} // namespace
+
+int main(int argc, char **argv)
+{
+	ScanOptions options;
+	if (!ParseOptions(argc, argv, options)) {
+		PrintUsage();
+		return 64;
+	}
+
+	// Disable error dialogs.
+	HeadlessMode = true;
+
+	// RecreateItem reads these, so they are set once before any worker starts and never written again.
+	gbIsHellfire = options.hellfire;
+	gbIsMultiplayer = options.multiplayer;
+	Players.resize(1);
+	MyPlayer = &Players[0];
+	MyPlayer->_pClass = options.heroClass;
+
+	// Naming an item loads the font kerning used to fit names, which the threads share without locking, so it is loaded
+	// here first. The translation caches of the name formats may be filled by any thread (see TranslationCache).
+	{
+		Item item {};
+		RecreateItem(*MyPlayer, item, options.idx, options.createInfo, static_cast<int>(options.firstSeed), options.value, options.hellfire);
+	}
+
+	WorkerPool workers { options.numThreads - 1 };
+	std::vector<std::vector<Match>> results(ChunksPerBatch);
+	size_t numMatches = 0;
+	const uint32_t startTicks = SDL_GetTicks();
+
+	std::puts("seed,quality,prefix,suffix,unique,name");
+	const uint64_t numChunks = (options.numSeeds + SeedsPerChunk - 1) / SeedsPerChunk;
+	for (uint64_t batch = 0; batch < numChunks; batch += ChunksPerBatch) {
+		const auto batchSize = static_cast<unsigned>(std::min<uint64_t>(numChunks - batch, ChunksPerBatch));
+		workers.parallelFor(batchSize, [&](unsigned i) {
+			const uint64_t first = (batch + i) * SeedsPerChunk;
+			ScanChunk(options, first, std::min(first + SeedsPerChunk, options.numSeeds), results[i]);
+		});
+		// Printed in seed order, independent of which thread scanned which chunk.
+		for (unsigned i = 0; i < batchSize; i++) {
+			for (const Match &match : results[i]) {
+				fmt::print("{},{},{},{},{},\"{}\"\n", static_cast<uint32_t>(match.seed), static_cast<int>(match.quality),
+				    static_cast<int>(match.prefix), static_cast<int>(match.suffix), match.unique, match.name);
+			}
+			numMatches += results[i].size();
+			results[i].clear();
+		}
+	}
+
+	const uint32_t elapsed = std::max<uint32_t>(SDL_GetTicks() - startTicks, 1);
+	std::fprintf(stderr, "%llu seeds, %zu matches, %u threads: %.3f seconds, %.0f seeds per second\n",
+	    static_cast<unsigned long long>(options.numSeeds), numMatches, workers.size() + 1, elapsed / 1000.0,
+	    options.numSeeds * 1000.0 / elapsed);
+	return 0;
+}